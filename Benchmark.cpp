@@ -0,0 +1,1197 @@
+/**
+ * @file Benchmark.cpp
+ * @brief Microbenchmarks for the Fraction library.
+ *
+ * Build and run with `make bench && ./bench`. The benchmark is compiled with optimizations, separately from
+ * the test objects. Each case runs over a fixed pseudo-random data set so results are comparable between runs.
+ *
+ * Every case reports the time per operation, the operations per second and the heap allocations per
+ * operation, counted by the replacement operator new below. Options:
+ *   --filter=TEXT  run only the cases whose name contains TEXT
+ *   --json=FILE    also write the results to FILE as JSON (`make bench-json` writes bench.json), so runs of
+ *                  different commits can be compared
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "sources/Fraction.hpp"
+#include "sources/FractionAccumulator.hpp"
+#include "sources/HybridFraction.hpp"
+#include "sources/FractionVector.hpp"
+#include "sources/FractionParser.hpp"
+#include "sources/FractionFile.hpp"
+#include "sources/FractionBinary.hpp"
+#include "sources/FractionHash.hpp"
+#include "sources/FractionPool.hpp"
+
+using namespace ariel;
+
+namespace
+{
+    // The number of heap allocations made so far
+    std::atomic<std::size_t> allocations{0};
+}
+
+// Replacement allocation functions, counting every allocation made by the benchmarked code
+void *operator new(std::size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void *memory = std::malloc(size == 0 ? 1 : size))
+    {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+// Kept out of line: inlined into a caller, std::free would be paired with the operator new call there and
+// g++ reports a mismatched deallocation (-Wmismatched-new-delete)
+__attribute__((noinline)) void operator delete(void *memory) noexcept
+{
+    std::free(memory);
+}
+
+__attribute__((noinline)) void operator delete[](void *memory) noexcept
+{
+    std::free(memory);
+}
+
+// The sized forms release through the unsized ones
+void operator delete(void *memory, std::size_t) noexcept
+{
+    operator delete(memory);
+}
+
+void operator delete[](void *memory, std::size_t) noexcept
+{
+    operator delete[](memory);
+}
+
+namespace
+{
+    // Keeps the optimizer from discarding a benchmarked result
+    template <typename T>
+    void keep(T const &value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct Result
+    {
+        std::string group;
+        std::string name;
+        double ns_per_op;
+        double ops_per_sec;
+        double allocs_per_op;
+    };
+
+    std::vector<Result> results;
+    std::string current_group;
+    bool group_printed = false;
+    const char *filter = nullptr;
+
+    // Starts a group of cases; the name heads the text output of its first selected case and tags the JSON results
+    void group(const char *name)
+    {
+        current_group = name;
+        group_printed = false;
+    }
+
+    bool selected(const char *name)
+    {
+        return filter == nullptr || std::strstr(name, filter) != nullptr;
+    }
+
+    // Times body, which performs ops operations, and records the result
+    template <typename Body>
+    void measure(const char *name, std::size_t ops, Body body, const char *note = "")
+    {
+        std::size_t allocations_before = allocations.load(std::memory_order_relaxed);
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        std::size_t allocated = allocations.load(std::memory_order_relaxed) - allocations_before;
+
+        if (!group_printed)
+        {
+            std::printf("== %s ==\n", current_group.c_str());
+            group_printed = true;
+        }
+
+        Result result{current_group, name, elapsed / static_cast<double>(ops), 0, static_cast<double>(allocated) / static_cast<double>(ops)};
+        result.ops_per_sec = result.ns_per_op > 0 ? 1e9 / result.ns_per_op : 0;
+        std::printf("%-40s %10.2f ns/op %14.0f ops/s %8.2f allocs/op%s\n", name, result.ns_per_op, result.ops_per_sec,
+                    result.allocs_per_op, note);
+        results.push_back(std::move(result));
+    }
+
+    // Runs body over every element of data, repeated rounds times, and reports the time per element
+    template <typename T, typename Body>
+    void run(const char *name, const std::vector<T> &data, int rounds, Body body)
+    {
+        if (!selected(name))
+        {
+            return;
+        }
+        measure(name, data.size() * static_cast<std::size_t>(rounds), [&]()
+                {
+                    for (int round = 0; round < rounds; ++round)
+                    {
+                        for (const T &item : data)
+                        {
+                            body(item);
+                        }
+                    } });
+    }
+
+    // Runs a batch operation over elements items rounds times, and reports the time per item
+    template <typename Body>
+    void run_batch(const char *name, std::size_t elements, int rounds, Body body)
+    {
+        if (!selected(name))
+        {
+            return;
+        }
+        measure(name, elements * static_cast<std::size_t>(rounds), [&]()
+                {
+                    for (int round = 0; round < rounds; ++round)
+                    {
+                        body();
+                    } });
+    }
+
+    // Writes the recorded results as a JSON document
+    bool write_json(const char *path)
+    {
+        FILE *file = std::fopen(path, "w");
+        if (file == nullptr)
+        {
+            return false;
+        }
+        std::fprintf(file, "{\n  \"benchmarks\": [\n");
+        for (std::size_t i = 0; i < results.size(); ++i)
+        {
+            const Result &result = results[i];
+            std::fprintf(file, "    {\"group\": \"%s\", \"name\": \"%s\", \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f, \"allocs_per_op\": %.4f}%s\n",
+                         result.group.c_str(), result.name.c_str(), result.ns_per_op, result.ops_per_sec, result.allocs_per_op,
+                         i + 1 < results.size() ? "," : "");
+        }
+        std::fprintf(file, "  ]\n}\n");
+        return std::fclose(file) == 0;
+    }
+
+    struct Pair
+    {
+        unsigned int a;
+        unsigned int b;
+    };
+
+    // Pairs with both values drawn uniformly from [low, high]
+    std::vector<Pair> uniform_pairs(unsigned int low, unsigned int high, std::size_t count)
+    {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<unsigned int> dist(low, high);
+        std::vector<Pair> pairs(count);
+        for (Pair &pair : pairs)
+        {
+            pair = {dist(gen), dist(gen)};
+        }
+        return pairs;
+    }
+
+    // Pairs of products of two 5-digit numbers, as produced by "Multiplying big fractions" in StudentTest2
+    std::vector<Pair> product_pairs(std::size_t count)
+    {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<unsigned int> dist(10000, 46340);
+        std::vector<Pair> pairs(count);
+        for (Pair &pair : pairs)
+        {
+            pair = {dist(gen) * dist(gen), dist(gen) * dist(gen)};
+        }
+        return pairs;
+    }
+
+    // Fractions with 5-digit numerators and denominators, as in "Multiplying/Dividing big fractions"
+    std::vector<std::pair<Fraction, Fraction>> big_fractions(std::size_t count)
+    {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(10000, 46340);
+        std::vector<std::pair<Fraction, Fraction>> fractions;
+        fractions.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            fractions.emplace_back(Fraction(dist(gen), dist(gen)), Fraction(dist(gen), dist(gen)));
+        }
+        return fractions;
+    }
+
+    struct Operands
+    {
+        Fraction lhs;
+        Fraction rhs;
+        float value; // A float operand, never zero
+        int num;     // Unreduced terms sharing a common factor
+        int den;
+    };
+
+    // Small signed fractions and floats, as in the unit tests
+    std::vector<Operands> operator_data(std::size_t count)
+    {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(1, 1000);
+        std::uniform_int_distribution<int> sign(0, 1);
+        std::vector<Operands> data;
+        data.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            int factor = dist(gen);
+            int lhs_num = sign(gen) == 0 ? dist(gen) : -dist(gen);
+            data.push_back({Fraction(lhs_num, dist(gen)), Fraction(dist(gen), dist(gen)), static_cast<float>(dist(gen)) / 64.0F,
+                            dist(gen) * factor, dist(gen) * factor});
+        }
+        return data;
+    }
+
+    // The float constructor, mixed arithmetic and float equality at a precision of Decimals places
+    template <int Decimals>
+    void bench_precision(const std::vector<Operands> &operands, int rounds)
+    {
+        using Decimal = DecimalFraction<Decimals>;
+        struct Item
+        {
+            Decimal lhs;
+            float value;
+        };
+        std::vector<Item> data;
+        data.reserve(operands.size());
+        for (const Operands &item : operands)
+        {
+            // Quotients by floats of at least 1 stay in the range of int terms with 6 decimals
+            data.push_back({Decimal(item.lhs.getNumerator(), item.lhs.getDenominator()), item.value + 1.0F});
+        }
+
+        const std::string suffix = ", " + std::to_string(Decimals) + " decimals";
+        auto label = [&suffix](const char *name)
+        { return std::string(name) + suffix; };
+        run(label("Fraction(float)").c_str(), data, rounds, [](const Item &item)
+            { keep(Decimal(item.value)); });
+        run(label("Fraction + float").c_str(), data, rounds, [](const Item &item)
+            {
+                Decimal lhs = item.lhs;
+                keep(lhs + item.value); });
+        run(label("Fraction / float").c_str(), data, rounds, [](const Item &item)
+            {
+                Decimal lhs = item.lhs;
+                keep(lhs / item.value); });
+        run(label("Fraction == float").c_str(), data, rounds, [](const Item &item)
+            {
+                Decimal lhs = item.lhs;
+                keep(lhs == item.value); });
+    }
+
+    // Every operator and conversion declared in Fraction.hpp
+    void bench_operators()
+    {
+        const auto data = operator_data(1 << 16);
+        const int rounds = 20;
+        using Item = Operands;
+
+        group("construction");
+        run("Fraction(int, int) reduced", data, rounds, [](const Item &item)
+            { keep(Fraction(item.lhs.getNumerator(), item.lhs.getDenominator())); });
+        run("Fraction(int, int) reduce", data, rounds, [](const Item &item)
+            { keep(Fraction(item.num, item.den)); });
+        run("Fraction(float)", data, rounds, [](const Item &item)
+            { keep(Fraction(item.value)); });
+        run("Fraction(double)", data, rounds, [](const Item &item)
+            { keep(Fraction(static_cast<double>(item.value))); });
+        run("from_double Truncate", data, rounds, [](const Item &item)
+            { keep(Fraction::from_double(item.value, FloatConversion::Truncate)); });
+        run("from_double Exact", data, rounds, [](const Item &item)
+            { keep(Fraction::from_double(item.value, FloatConversion::Exact)); });
+        run("from_double Approximate, max 1000", data, rounds, [](const Item &item)
+            { keep(Fraction::from_double(item.value / 3.0, FloatConversion::Approximate, 1000)); });
+        run("from_double Approximate, max INT_MAX", data, rounds, [](const Item &item)
+            { keep(Fraction::from_double(item.value / 3.0, FloatConversion::Approximate)); });
+        run("Fraction = float", data, rounds, [](const Item &item)
+            {
+                Fraction fraction;
+                fraction = item.value;
+                keep(fraction); });
+
+        group("arithmetic");
+        run("Fraction + Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs + item.rhs); });
+        run("Fraction - Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs - item.rhs); });
+        run("Fraction * Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs * item.rhs); });
+        run("Fraction / Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs / item.rhs); });
+        run("Fraction + float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs + item.value); });
+        run("Fraction - float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs - item.value); });
+        run("Fraction * float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs * item.value); });
+        run("Fraction / float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs / item.value); });
+        run("float + Fraction", data, rounds, [](const Item &item)
+            { keep(item.value + item.rhs); });
+        run("float - Fraction", data, rounds, [](const Item &item)
+            { keep(item.value - item.rhs); });
+        run("float * Fraction", data, rounds, [](const Item &item)
+            { keep(item.value * item.rhs); });
+        run("float / Fraction", data, rounds, [](const Item &item)
+            { keep(item.value / item.rhs); });
+        run("checked_add", data, rounds, [](const Item &item)
+            { keep(Fraction::checked_add(item.lhs, item.rhs)); });
+        run("checked_sub", data, rounds, [](const Item &item)
+            { keep(Fraction::checked_sub(item.lhs, item.rhs)); });
+        run("checked_mul", data, rounds, [](const Item &item)
+            { keep(Fraction::checked_mul(item.lhs, item.rhs)); });
+        run("checked_div", data, rounds, [](const Item &item)
+            { keep(Fraction::checked_div(item.lhs, item.rhs)); });
+
+        group("compound assignment");
+        run("Fraction += Fraction", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs += item.rhs;
+                keep(lhs); });
+        run("Fraction -= Fraction", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs -= item.rhs;
+                keep(lhs); });
+        run("Fraction *= Fraction", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs *= item.rhs;
+                keep(lhs); });
+        run("Fraction /= Fraction", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs /= item.rhs;
+                keep(lhs); });
+        run("Fraction += float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs += item.value;
+                keep(lhs); });
+        run("Fraction -= float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs -= item.value;
+                keep(lhs); });
+        run("Fraction *= float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs *= item.value;
+                keep(lhs); });
+        run("Fraction /= float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                lhs /= item.value;
+                keep(lhs); });
+        run("++Fraction", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(++lhs); });
+        run("Fraction++", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs++);
+                keep(lhs); });
+        run("--Fraction", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(--lhs); });
+        run("Fraction--", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs--);
+                keep(lhs); });
+
+        group("comparison");
+        run("Fraction == Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs == item.rhs); });
+        run("Fraction != Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs != item.rhs); });
+        run("Fraction < Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs < item.rhs); });
+        run("Fraction > Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs > item.rhs); });
+        run("Fraction <= Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs <= item.rhs); });
+        run("Fraction >= Fraction", data, rounds, [](const Item &item)
+            { keep(item.lhs >= item.rhs); });
+        run("Fraction == float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs == item.value); });
+        run("Fraction < float", data, rounds, [](const Item &item)
+            {
+                Fraction lhs = item.lhs;
+                keep(lhs < item.value); });
+        run("float == Fraction", data, rounds, [](const Item &item)
+            { keep(item.value == item.rhs); });
+        run("float < Fraction", data, rounds, [](const Item &item)
+            { keep(item.value < item.rhs); });
+        run("Fraction::compare", data, rounds, [](const Item &item)
+            { keep(Fraction::compare(item.lhs, item.rhs)); });
+
+        // The same float interoperation at the other compiled-in precisions
+        group("decimal precision");
+        bench_precision<2>(data, rounds);
+        bench_precision<6>(data, rounds);
+
+        group("conversion and stream I/O");
+        run("to_float()", data, rounds, [](const Item &item)
+            { keep(item.lhs.to_float()); });
+        run("to_double()", data, rounds, [](const Item &item)
+            { keep(item.lhs.to_double()); });
+        run("std::string(Fraction)", data, rounds, [](const Item &item)
+            { keep(std::string(item.lhs)); });
+        std::ostringstream out;
+        run("ostream << Fraction", data, rounds, [&out](const Item &item)
+            {
+                out.seekp(0);
+                out << item.lhs;
+                keep(out.tellp()); });
+        run("Fraction::format_to", data, rounds, [](const Item &item)
+            {
+                char buffer[Fraction::max_chars];
+                keep(item.lhs.format_to(buffer));
+                keep(buffer); });
+        std::vector<std::string> texts;
+        for (const Item &item : data)
+        {
+            texts.push_back(std::to_string(item.num) + " " + std::to_string(item.den));
+        }
+        std::istringstream in;
+        run("istream >> Fraction", texts, rounds, [&in](const std::string &text)
+            {
+                in.clear();
+                in.str(text);
+                Fraction fraction;
+                in >> fraction;
+                keep(fraction); });
+    }
+
+    void bench_parsing()
+    {
+        // One fraction per line, in both accepted forms
+        const std::size_t count = 1 << 20;
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(-1000000, 1000000);
+        std::string text;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            int den = dist(gen);
+            text += std::to_string(dist(gen)) + (i % 2 == 0 ? "/" : " ") + std::to_string(den == 0 ? 1 : den) + "\n";
+        }
+        std::vector<Fraction> fractions;
+        fractions.reserve(count);
+
+        char note[32];
+        std::snprintf(note, sizeof(note), " (%.1f MB)", static_cast<double>(text.size()) / 1e6);
+        group("parsing");
+        if (selected("istream >> Fraction, whole text"))
+        {
+            measure("istream >> Fraction, whole text", count, [&]()
+                    {
+                        std::istringstream in(text);
+                        fractions.clear();
+                        Fraction fraction;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            in >> fraction;
+                            fractions.push_back(fraction);
+                        } }, note);
+        }
+        if (selected("parse_fractions, whole text"))
+        {
+            measure("parse_fractions, whole text", count, [&]()
+                    {
+                        fractions.clear();
+                        keep(parse_fractions(text.data(), text.data() + text.size(), std::back_inserter(fractions)).error); }, note);
+        }
+
+        // The same text as a file
+        const char *path = "bench_fractions.txt";
+        {
+            std::ofstream file(path);
+            file << text;
+        }
+        if (selected("ifstream >> Fraction, file"))
+        {
+            measure("ifstream >> Fraction, file", count, [&]()
+                    {
+                        std::ifstream in(path);
+                        fractions.clear();
+                        Fraction fraction;
+                        for (std::size_t i = 0; i < count; ++i)
+                        {
+                            in >> fraction;
+                            fractions.push_back(fraction);
+                        } }, note);
+        }
+        std::vector<unsigned int> thread_counts = {1};
+        if (std::thread::hardware_concurrency() > 1)
+        {
+            thread_counts.push_back(std::thread::hardware_concurrency());
+        }
+        for (unsigned int threads : thread_counts)
+        {
+            std::string name = "load_fractions, file, " + std::to_string(threads) + " threads";
+            if (selected(name.c_str()))
+            {
+                measure(name.c_str(), count, [&]()
+                        { keep(load_fractions(path, threads).size()); }, note);
+            }
+        }
+        std::remove(path);
+    }
+
+    void bench_binary()
+    {
+        const std::size_t count = 1 << 20;
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(-1000000, 1000000);
+        std::vector<Fraction> fractions;
+        fractions.reserve(count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            int den = dist(gen);
+            fractions.emplace_back(dist(gen), den == 0 ? 1 : den);
+        }
+
+        group("binary format");
+        for (binary::Encoding encoding : {binary::Encoding::Fixed, binary::Encoding::Varint})
+        {
+            const char *label = encoding == binary::Encoding::Fixed ? "fixed" : "varint";
+            std::vector<char> bytes = binary::encode(fractions, encoding);
+            char note[32];
+            std::snprintf(note, sizeof(note), " (%.2f bytes/fraction)", static_cast<double>(bytes.size()) / count);
+            std::string name = std::string("encode, ") + label;
+            if (selected(name.c_str()))
+            {
+                measure(name.c_str(), count, [&]()
+                        { keep(binary::encode(fractions, encoding).size()); }, note);
+            }
+            name = std::string("decode, ") + label;
+            if (selected(name.c_str()))
+            {
+                measure(name.c_str(), count, [&]()
+                        { keep(binary::decode(bytes.data(), bytes.size()).size()); }, note);
+            }
+            if (encoding == binary::Encoding::Fixed && selected("FractionView, sum of numerators"))
+            {
+                measure("FractionView, sum of numerators", count, [&]()
+                        {
+                            binary::FractionView view(bytes.data(), bytes.size());
+                            long long int sum = 0;
+                            for (std::size_t i = 0; i < view.size(); ++i)
+                            {
+                                sum += view.numerator(i);
+                            }
+                            keep(sum); });
+            }
+        }
+    }
+
+    void bench_gcd()
+    {
+        const std::size_t count = 1 << 16;
+        const int rounds = 20;
+
+        struct Range
+        {
+            const char *name;
+            std::vector<Pair> pairs;
+        };
+        Range ranges[] = {
+            {"small [1, 1000]", uniform_pairs(1, 1000, count)},
+            {"medium [1, 46340]", uniform_pairs(1, 46340, count)},
+            {"full [1, 2^31)", uniform_pairs(1, 2147483647U, count)},
+            {"big products", product_pairs(count)},
+        };
+
+        group("gcd engines");
+        for (const Range &range : ranges)
+        {
+            std::string euclid_name = std::string("euclid  ") + range.name;
+            std::string binary_name = std::string("binary  ") + range.name;
+            run(euclid_name.c_str(), range.pairs, rounds, [](const Pair &pair)
+                { keep(gcd::euclid(pair.a, pair.b)); });
+            run(binary_name.c_str(), range.pairs, rounds, [](const Pair &pair)
+                { keep(gcd::binary(pair.a, pair.b)); });
+        }
+    }
+
+    void bench_big_fractions()
+    {
+        auto fractions = big_fractions(1 << 16);
+        const int rounds = 20;
+
+        group("big fractions");
+        run("Fraction * Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            {
+                try
+                {
+                    keep(pair.first * pair.second);
+                }
+                catch (const std::overflow_error &)
+                {
+                } });
+        run("Fraction / Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            {
+                try
+                {
+                    keep(pair.first / pair.second);
+                }
+                catch (const std::overflow_error &)
+                {
+                } });
+    }
+
+    // Times one call of body and reports the time per element of a data set of the given size
+    template <typename Body>
+    void run_once(const char *name, std::size_t size, Body body)
+    {
+        if (selected(name))
+        {
+            measure(name, size, body);
+        }
+    }
+
+    void bench_sort()
+    {
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(1, 1000000);
+        std::vector<Fraction> fractions;
+        for (int i = 0; i < (1 << 18); ++i)
+        {
+            fractions.emplace_back(dist(gen), dist(gen));
+        }
+
+        group("comparisons");
+        auto exact = fractions;
+        run_once("sort by exact operator<", exact.size(), [&]()
+                 { std::sort(exact.begin(), exact.end()); });
+        auto by_float = fractions;
+        run_once("sort by to_float()", by_float.size(), [&]()
+                 { std::sort(by_float.begin(), by_float.end(), [](const Fraction &lhs, const Fraction &rhs)
+                             { return lhs.to_float() < rhs.to_float(); }); });
+        run_once("binary_search by exact operator<", exact.size(), [&]()
+                 {
+                     for (const Fraction &fraction : fractions)
+                     {
+                         keep(std::binary_search(exact.begin(), exact.end(), fraction));
+                     } });
+
+        // Fractions are trivially copyable, so these are memcpy and memmove of the terms
+        group("bulk copies");
+        run_once("copy std::vector<Fraction>", fractions.size(), [&]()
+                 {
+                     std::vector<Fraction> copy = fractions;
+                     keep(copy.back()); });
+        run_once("push_back into std::vector<Fraction>", fractions.size(), [&]()
+                 {
+                     std::vector<Fraction> grown;
+                     for (const Fraction &fraction : fractions)
+                     {
+                         grown.push_back(fraction);
+                     }
+                     keep(grown.back()); });
+        run_once("insert at the front of std::vector<Fraction>", 1024, [&]()
+                 {
+                     std::vector<Fraction> shifted(fractions.begin(), fractions.begin() + 4096);
+                     for (int i = 0; i < 1024; ++i)
+                     {
+                         shifted.insert(shifted.begin(), fractions[static_cast<std::size_t>(i)]);
+                     }
+                     keep(shifted.front()); });
+    }
+
+    // The arithmetic core as it was before the overflow intrinsics: widen every product to long long,
+    // range-check the results, then let the constructor check and reduce them again
+    int narrowed(long long value)
+    {
+        if (value > std::numeric_limits<int>::max() || value < std::numeric_limits<int>::min())
+        {
+            throw std::overflow_error("Overflow");
+        }
+        return static_cast<int>(value);
+    }
+
+    Fraction widened_add(const Fraction &lhs, const Fraction &rhs)
+    {
+        long long num = static_cast<long long>(lhs.getNumerator()) * rhs.getDenominator() +
+                        static_cast<long long>(rhs.getNumerator()) * lhs.getDenominator();
+        long long den = static_cast<long long>(lhs.getDenominator()) * rhs.getDenominator();
+        return Fraction(narrowed(num), narrowed(den));
+    }
+
+    Fraction widened_sub(const Fraction &lhs, const Fraction &rhs)
+    {
+        long long num = static_cast<long long>(lhs.getNumerator()) * rhs.getDenominator() -
+                        static_cast<long long>(rhs.getNumerator()) * lhs.getDenominator();
+        long long den = static_cast<long long>(lhs.getDenominator()) * rhs.getDenominator();
+        return Fraction(narrowed(num), narrowed(den));
+    }
+
+    Fraction widened_mul(const Fraction &lhs, const Fraction &rhs)
+    {
+        auto cross1 = static_cast<long long>(gcd::compute(static_cast<unsigned int>(std::abs(lhs.getNumerator())), static_cast<unsigned int>(std::abs(rhs.getDenominator()))));
+        auto cross2 = static_cast<long long>(gcd::compute(static_cast<unsigned int>(std::abs(rhs.getNumerator())), static_cast<unsigned int>(std::abs(lhs.getDenominator()))));
+        long long num = (lhs.getNumerator() / cross1) * (rhs.getNumerator() / cross2);
+        long long den = (lhs.getDenominator() / cross2) * (rhs.getDenominator() / cross1);
+        return Fraction(narrowed(num), narrowed(den));
+    }
+
+    Fraction widened_div(const Fraction &lhs, const Fraction &rhs)
+    {
+        if (rhs.getNumerator() == 0)
+        {
+            throw std::runtime_error("Can't divide by zero");
+        }
+        return widened_mul(lhs, Fraction(rhs.getDenominator(), rhs.getNumerator()));
+    }
+
+    void bench_overflow_checks()
+    {
+        // The randomized workload of Test.cpp: terms in [0, 100) over denominators in [1, 100], all four operators
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> num_dist(0, 99);
+        std::uniform_int_distribution<int> den_dist(1, 100);
+        std::vector<std::pair<Fraction, Fraction>> operands;
+        for (int i = 0; i < (1 << 16); ++i)
+        {
+            // Test.cpp divides by f2, so its numerator is kept nonzero here
+            operands.emplace_back(Fraction(num_dist(gen), den_dist(gen)), Fraction(num_dist(gen) + 1, den_dist(gen)));
+        }
+        using Item = std::pair<Fraction, Fraction>;
+
+        group("overflow checks, Test.cpp randomized workload");
+        run("widened range checks, + - * /", operands, 10, [](const Item &item)
+            {
+                keep(widened_add(item.first, item.second));
+                keep(widened_sub(item.first, item.second));
+                keep(widened_mul(item.first, item.second));
+                keep(widened_div(item.first, item.second)); });
+        run("overflow intrinsics, + - * /", operands, 10, [](const Item &item)
+            {
+                keep(item.first + item.second);
+                keep(item.first - item.second);
+                keep(item.first * item.second);
+                keep(item.first / item.second); });
+    }
+
+    void bench_checked()
+    {
+        // Sums of 5-digit fractions, about one in twenty of which overflows int
+        const auto fractions = big_fractions(1 << 16);
+        using Item = std::pair<Fraction, Fraction>;
+
+        group("overflow handling");
+        run("Fraction + Fraction, catching overflow", fractions, 5, [](const Item &item)
+            {
+                try
+                {
+                    keep(item.first + item.second);
+                }
+                catch (const std::overflow_error &)
+                {
+                    keep(0);
+                } });
+        run("checked_add, testing the error", fractions, 5, [](const Item &item)
+            {
+                Checked<Fraction> sum = Fraction::checked_add(item.first, item.second);
+                keep(sum.ok() ? sum.value : Fraction()); });
+    }
+
+    void bench_hashing()
+    {
+        // Counting the distinct values among 2^20 fractions with small terms, about 6000 of them
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(1, 100);
+        std::vector<Fraction> fractions;
+        for (int i = 0; i < (1 << 20); ++i)
+        {
+            fractions.emplace_back(dist(gen), dist(gen));
+        }
+
+        group("hashing and deduplication");
+        run("std::hash<Fraction>", fractions, 10, [](const Fraction &fraction)
+            { keep(std::hash<Fraction>()(fraction)); });
+        run_once("count in unordered_map<std::string>", fractions.size(), [&]()
+                 {
+                     std::unordered_map<std::string, int> counts;
+                     for (const Fraction &fraction : fractions)
+                     {
+                         ++counts[std::string(fraction)];
+                     }
+                     keep(counts.size()); });
+        run_once("count in unordered_map<Fraction>", fractions.size(), [&]()
+                 {
+                     std::unordered_map<Fraction, int> counts;
+                     for (const Fraction &fraction : fractions)
+                     {
+                         ++counts[fraction];
+                     }
+                     keep(counts.size()); });
+        run_once("count in FractionHashMap", fractions.size(), [&]()
+                 {
+                     FractionHashMap<int> counts;
+                     for (const Fraction &fraction : fractions)
+                     {
+                         ++counts[fraction];
+                     }
+                     keep(counts.size()); });
+
+        // Lookups of present keys in a prebuilt table
+        std::unordered_map<std::string, int> by_string;
+        std::unordered_map<Fraction, int> by_fraction;
+        FractionHashMap<int> by_map;
+        for (const Fraction &fraction : fractions)
+        {
+            by_string[std::string(fraction)] = 1;
+            by_fraction[fraction] = 1;
+            by_map[fraction] = 1;
+        }
+        run("find in unordered_map<std::string>", fractions, 1, [&by_string](const Fraction &fraction)
+            { keep(by_string.find(std::string(fraction)) != by_string.end()); });
+        run("find in unordered_map<Fraction>", fractions, 1, [&by_fraction](const Fraction &fraction)
+            { keep(by_fraction.find(fraction) != by_fraction.end()); });
+        run("find in FractionHashMap", fractions, 1, [&by_map](const Fraction &fraction)
+            { keep(by_map.find(fraction) != nullptr); });
+    }
+
+    void bench_interning()
+    {
+        // Common fractions with terms up to 12, and larger ones that are stored in the pool
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> small(1, 12);
+        std::uniform_int_distribution<int> large(100, 400);
+        std::vector<std::pair<int, int>> common;
+        std::vector<std::pair<int, int>> stored;
+        for (int i = 0; i < (1 << 16); ++i)
+        {
+            common.emplace_back(small(gen), small(gen));
+            stored.emplace_back(large(gen), large(gen));
+        }
+
+        FractionPool pool;
+        group("interning");
+        run("Fraction(int, int), small terms", common, 20, [](const std::pair<int, int> &terms)
+            { keep(Fraction(terms.first, terms.second)); });
+        run("FractionPool::intern, small terms", common, 20, [&pool](const std::pair<int, int> &terms)
+            { keep(pool.intern(terms.first, terms.second)); });
+        run("FractionPool::get, small terms", common, 20, [&pool](const std::pair<int, int> &terms)
+            { keep(pool.get(pool.intern(terms.first, terms.second))); });
+        run("Fraction(int, int), large terms", stored, 20, [](const std::pair<int, int> &terms)
+            { keep(Fraction(terms.first, terms.second)); });
+        run("FractionPool::intern, large terms", stored, 20, [&pool](const std::pair<int, int> &terms)
+            { keep(pool.intern(terms.first, terms.second)); });
+    }
+
+    void bench_accumulate()
+    {
+        // Small signed numerators over a fixed set of denominators, so the running sum stays within int
+        const int denominators[] = {1, 2, 3, 4, 5, 6, 8, 10, 12, 16, 20, 25, 50, 100};
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> num_dist(-9, 9);
+        std::uniform_int_distribution<std::size_t> den_dist(0, std::size(denominators) - 1);
+        std::vector<Fraction> terms;
+        for (int i = 0; i < 10000000; ++i)
+        {
+            terms.emplace_back(num_dist(gen), denominators[den_dist(gen)]);
+        }
+
+        group("accumulation of 10^7 terms");
+        run_once("Fraction sum = sum + term", terms.size(), [&]()
+                 {
+                     Fraction sum;
+                     for (const Fraction &term : terms)
+                     {
+                         sum = sum + term;
+                     }
+                     keep(sum); });
+        run_once("FractionAccumulator += term", terms.size(), [&]()
+                 {
+                     FractionAccumulator sum;
+                     for (const Fraction &term : terms)
+                     {
+                         sum += term;
+                     }
+                     keep(sum.to_fraction()); });
+    }
+
+    void bench_long_sums()
+    {
+        // Harmonic-like sums, where the running denominator is the lcm of the terms' denominators
+        const int rounds = 20000;
+        group("harmonic-like sums");
+
+        // H_18 is the longest harmonic sum that a * d + c * b over b * d kept within int
+        run_once("harmonic sums 1/1 + ... + 1/18", static_cast<std::size_t>(rounds) * 18, [&]()
+                 {
+                     for (int round = 0; round < rounds; ++round)
+                     {
+                         Fraction sum;
+                         for (int k = 1; k <= 18; ++k)
+                         {
+                             sum = sum + Fraction(1, k);
+                         }
+                         keep(sum);
+                     } });
+        run_once("alternating harmonic sums 1/1 - ... - 1/18", static_cast<std::size_t>(rounds) * 18, [&]()
+                 {
+                     for (int round = 0; round < rounds; ++round)
+                     {
+                         Fraction sum;
+                         for (int k = 1; k <= 18; ++k)
+                         {
+                             sum = k % 2 == 1 ? sum + Fraction(1, k) : sum - Fraction(1, k);
+                         }
+                         keep(sum);
+                     } });
+
+        // The partial sums are k/(k+1), and b * d is about k^3, which fits in int up to k = 1000
+        run_once("telescoping sums of 1/(k(k+1)), 1000 terms", static_cast<std::size_t>(rounds / 20) * 1000, [&]()
+                 {
+                     for (int round = 0; round < rounds / 20; ++round)
+                     {
+                         Fraction sum;
+                         for (int k = 1; k <= 1000; ++k)
+                         {
+                             sum = sum + Fraction(1, k * (k + 1));
+                         }
+                         keep(sum);
+                     } });
+    }
+
+    // Multiplication as it was before cross-cancellation: widen, range-check the full product, then reduce
+    Fraction widen_multiply(const Fraction &lhs, const Fraction &rhs)
+    {
+        long long int num = static_cast<long long int>(lhs.getNumerator()) * rhs.getNumerator();
+        long long int denom = static_cast<long long int>(lhs.getDenominator()) * rhs.getDenominator();
+        if (num > std::numeric_limits<int>::max() || num < std::numeric_limits<int>::min() ||
+            denom > std::numeric_limits<int>::max() || denom < std::numeric_limits<int>::min())
+        {
+            Fraction::error_overflow();
+        }
+        return Fraction(static_cast<int>(num), static_cast<int>(denom));
+    }
+
+    void bench_products()
+    {
+        const std::size_t count = 1 << 16;
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> factor(1, 46340);
+
+        // Independent terms below the square root of the int range: every product fits, and cross-cancelling
+        // rarely finds a common factor
+        std::vector<std::pair<Fraction, Fraction>> independent;
+        // Chained ratios (a*b)/c * (c*d)/b, whose operands share factors the way unit conversions do
+        std::vector<std::pair<Fraction, Fraction>> chained;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            independent.emplace_back(Fraction(factor(gen), factor(gen)), Fraction(factor(gen), factor(gen)));
+            int a = factor(gen), b = factor(gen), c = factor(gen), d = factor(gen);
+            chained.emplace_back(Fraction(a * b, c), Fraction(c * d, b));
+        }
+
+        group("products");
+        auto time_products = [](const char *name, const std::vector<std::pair<Fraction, Fraction>> &data, auto multiply)
+        {
+            if (!selected(name))
+            {
+                return;
+            }
+            // The share of overflowing products, counted in an untimed pass
+            std::size_t overflows = 0;
+            for (const auto &pair : data)
+            {
+                try
+                {
+                    keep(multiply(pair.first, pair.second));
+                }
+                catch (const std::overflow_error &)
+                {
+                    ++overflows;
+                }
+            }
+            char note[32];
+            std::snprintf(note, sizeof(note), " %6.1f%% overflow", 100.0 * static_cast<double>(overflows) / static_cast<double>(data.size()));
+
+            measure(name, data.size(), [&]()
+                    {
+                        for (const auto &pair : data)
+                        {
+                            try
+                            {
+                                keep(multiply(pair.first, pair.second));
+                            }
+                            catch (const std::overflow_error &)
+                            {
+                            }
+                        } }, note);
+        };
+
+        auto cancelled = [](const Fraction &lhs, const Fraction &rhs)
+        { return lhs * rhs; };
+
+        time_products("widen-then-reduce  independent terms", independent, widen_multiply);
+        time_products("cross-cancel       independent terms", independent, cancelled);
+        time_products("widen-then-reduce  chained ratios   ", chained, widen_multiply);
+        time_products("cross-cancel       chained ratios   ", chained, cancelled);
+    }
+
+    void bench_hybrid()
+    {
+        // Small operands whose results always fit, so both types stay on their fast paths
+        const std::size_t count = 1 << 16;
+        const int rounds = 20;
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(1, 1000);
+        std::vector<std::pair<Fraction, Fraction>> fractions;
+        std::vector<std::pair<HybridFraction, HybridFraction>> hybrids;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Fraction lhs(dist(gen), dist(gen));
+            Fraction rhs(dist(gen), dist(gen));
+            fractions.emplace_back(lhs, rhs);
+            hybrids.emplace_back(lhs, rhs);
+        }
+
+        group("hybrid fractions on small values");
+        run("Fraction + Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            { keep(pair.first + pair.second); });
+        run("HybridFraction + HybridFraction", hybrids, rounds, [](const std::pair<HybridFraction, HybridFraction> &pair)
+            { keep(pair.first + pair.second); });
+        run("Fraction * Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            { keep(pair.first * pair.second); });
+        run("HybridFraction * HybridFraction", hybrids, rounds, [](const std::pair<HybridFraction, HybridFraction> &pair)
+            { keep(pair.first * pair.second); });
+    }
+
+    void bench_vectors()
+    {
+        // One vector operation per round against the same loop over Fraction, per element
+        const std::size_t count = 1 << 16;
+        const int rounds = 20;
+        std::mt19937 gen(12345);
+        std::uniform_int_distribution<int> dist(1, 1000);
+        std::vector<std::pair<Fraction, Fraction>> fractions;
+        FractionVector lhs;
+        FractionVector rhs;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            Fraction left(dist(gen), dist(gen));
+            Fraction right(dist(gen), dist(gen));
+            fractions.emplace_back(left, right);
+            lhs.push_back(left);
+            rhs.push_back(right);
+        }
+
+        group("fraction vectors, 65536 elements");
+        run("Fraction + Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            { keep(pair.first + pair.second); });
+        run("Fraction * Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            { keep(pair.first * pair.second); });
+        run("Fraction < Fraction", fractions, rounds, [](const std::pair<Fraction, Fraction> &pair)
+            { keep(pair.first < pair.second); });
+
+        const simd::Isa isas[] = {simd::Isa::Scalar, simd::Isa::SSE4, simd::Isa::AVX2};
+        const char *names[] = {"scalar", "SSE4", "AVX2"};
+        for (simd::Isa isa : isas)
+        {
+            if (static_cast<int>(isa) > static_cast<int>(simd::best_isa()))
+            {
+                continue;
+            }
+            simd::set_isa(isa);
+            std::string suffix = std::string(" (") + names[static_cast<int>(isa)] + ")";
+            run_batch(("FractionVector +" + suffix).c_str(), count, rounds, [&]()
+                      { keep(lhs + rhs); });
+            run_batch(("FractionVector *" + suffix).c_str(), count, rounds, [&]()
+                      { keep(lhs * rhs); });
+            run_batch(("FractionVector compare" + suffix).c_str(), count, rounds, [&]()
+                      { keep(FractionVector::compare(lhs, rhs)); });
+        }
+        simd::set_isa(simd::best_isa());
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const char *json_path = nullptr;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strncmp(argv[i], "--filter=", 9) == 0)
+        {
+            filter = argv[i] + 9;
+        }
+        else if (std::strncmp(argv[i], "--json=", 7) == 0)
+        {
+            json_path = argv[i] + 7;
+        }
+        else
+        {
+            std::fprintf(stderr, "usage: %s [--filter=TEXT] [--json=FILE]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    bench_operators();
+    bench_parsing();
+    bench_binary();
+    bench_gcd();
+    bench_big_fractions();
+    bench_sort();
+    bench_overflow_checks();
+    bench_checked();
+    bench_hashing();
+    bench_interning();
+    bench_accumulate();
+    bench_long_sums();
+    bench_products();
+    bench_hybrid();
+    bench_vectors();
+
+    if (json_path != nullptr && !write_json(json_path))
+    {
+        std::fprintf(stderr, "cannot write %s\n", json_path);
+        return 1;
+    }
+    return 0;
+}
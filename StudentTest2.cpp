@@ -1,7 +1,24 @@
 #include <sstream>
+#include <filesystem>
+#include <fstream>
 #include "doctest.h"
 #include "sources/Fraction.hpp"
+#include "sources/FractionAccumulator.hpp"
+#include "sources/BigFraction.hpp"
+#include "sources/HybridFraction.hpp"
+#include "sources/FractionVector.hpp"
+#include "sources/FractionParser.hpp"
+#include "sources/FractionFile.hpp"
+#include "sources/FractionBinary.hpp"
+#include "sources/FractionHash.hpp"
+#include "sources/FractionPool.hpp"
+#include <cstring>
 #include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 using namespace std;
@@ -731,11 +748,12 @@ TEST_CASE("Fraction with largest possible numerator and/or denominator and overf
     // Test arithmetic with large numerator and/or denominator
     Fraction f4(MAXINT - 100, MAXINT);
 
-    CHECK_THROWS_AS(f1 * f4, std::overflow_error);
+    // Common factors are cancelled across the operands, so only results that really overflow throw
+    CHECK_EQ(f1 * f4, Fraction(MAXINT - 100, 1));
     CHECK_THROWS_AS(f1 / f4, std::overflow_error);
 
     CHECK_THROWS_AS(f2 * f4, std::overflow_error);
-    CHECK_THROWS_AS(f2 / f4, std::overflow_error); //
+    CHECK_EQ(f2 / f4, Fraction(1, MAXINT - 100));
 
     CHECK_NOTHROW(f3 * f4);
     CHECK_NOTHROW(f4 / f3);
@@ -753,3 +771,1528 @@ TEST_CASE("Fraction with largest possible numerator and/or denominator and overf
     CHECK_NOTHROW(f5 + Fraction{1, 1});
     CHECK_NOTHROW(f7 - Fraction{1, 1});
 }
+
+TEST_SUITE("Logging ring sink") {
+    TEST_CASE("Messages are batched until drained") {
+        logging::RingSink sink(4);
+        CHECK(sink.push(logging::Level::Trace, "first"));
+        CHECK(sink.push(logging::Level::Info, "second"));
+
+        std::ostringstream out;
+        CHECK_EQ(sink.drain(out), 2);
+        CHECK(out.str() == "[Fraction]: first\n[Fraction]: second\n");
+
+        // Draining an empty sink writes nothing
+        std::ostringstream empty;
+        CHECK_EQ(sink.drain(empty), 0);
+        CHECK(empty.str().empty());
+    }
+
+    TEST_CASE("A full sink drops messages instead of blocking") {
+        logging::RingSink sink(2);
+        CHECK(sink.push(logging::Level::Trace, "a"));
+        CHECK(sink.push(logging::Level::Trace, "b"));
+        CHECK_FALSE(sink.push(logging::Level::Trace, "c"));
+        CHECK_EQ(sink.dropped(), 1);
+
+        std::ostringstream out;
+        CHECK_EQ(sink.drain(out), 2);
+        CHECK(sink.push(logging::Level::Trace, "d"));
+    }
+
+    TEST_CASE("Installed sink captures the trace") {
+        logging::RingSink sink;
+        logging::set_sink(&sink);
+        logging::write(logging::Level::Info, "captured");
+        logging::set_sink(nullptr);
+
+        std::ostringstream out;
+        CHECK_EQ(sink.drain(out), 1);
+        CHECK(out.str() == "[Fraction]: captured\n");
+    }
+}
+
+TEST_SUITE("Compile-time arithmetic") {
+    TEST_CASE("Arithmetic on fractions is constant-folded") {
+        constexpr Fraction sum = Fraction{1, 2} + Fraction{3, 4};
+        static_assert(sum.getNumerator() == 5 && sum.getDenominator() == 4);
+
+        constexpr Fraction diff = Fraction{1, 2} - Fraction{3, 4};
+        static_assert(diff.getNumerator() == -1 && diff.getDenominator() == 4);
+
+        constexpr Fraction prod = Fraction{2, 3} * Fraction{3, 4};
+        static_assert(prod.getNumerator() == 1 && prod.getDenominator() == 2);
+
+        constexpr Fraction quot = Fraction{1, 2} / Fraction{3, 4};
+        static_assert(quot.getNumerator() == 2 && quot.getDenominator() == 3);
+
+        CHECK_EQ(sum, Fraction{5, 4});
+        CHECK_EQ(quot.to_double(), doctest::Approx(2.0 / 3.0));
+    }
+
+    TEST_CASE("Fraction is trivially copyable") {
+        CHECK(std::is_trivially_copyable_v<Fraction>);
+    }
+}
+
+TEST_SUITE("GCD engines") {
+    TEST_CASE("Binary and Euclid engines agree") {
+        CHECK_EQ(gcd::binary(0U, 0U), 0U);
+        CHECK_EQ(gcd::binary(0U, 7U), 7U);
+        CHECK_EQ(gcd::binary(12U, 0U), 12U);
+        CHECK_EQ(gcd::binary(48U, 180U), 12U);
+        CHECK_EQ(gcd::binary(2147483648U, 1024U), 1024U);
+        CHECK_EQ(gcd::binary(426729615U, 1071423168U), gcd::euclid(426729615U, 1071423168U));
+
+        int mismatches = 0;
+        for (unsigned int a = 0; a < 200; a++) {
+            for (unsigned int b = 0; b < 200; b++) {
+                mismatches += gcd::binary(a, b) != gcd::euclid(a, b) ? 1 : 0;
+            }
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+
+    TEST_CASE("Engines are usable at compile time") {
+        static_assert(gcd::compute<gcd::Engine::Binary>(84U, 36U) == 12U);
+        static_assert(gcd::compute<gcd::Engine::Euclid>(84ULL, 36ULL) == 12ULL);
+    }
+}
+
+TEST_SUITE("Exact comparisons") {
+    TEST_CASE("Fractions closer than float epsilon are ordered correctly") {
+        int MAXINT = std::numeric_limits<int>::max();
+        Fraction close1{MAXINT - 2, MAXINT - 1};
+        Fraction close2{MAXINT - 1, MAXINT};
+
+        // Both convert to the same float
+        CHECK_EQ(close1.to_float(), close2.to_float());
+
+        CHECK_LT(close1, close2);
+        CHECK_GT(close2, close1);
+        CHECK_FALSE((close2 <= close1));
+        CHECK_FALSE((close1 >= close2));
+        CHECK_LT(Fraction::compare(close1, close2), 0);
+        CHECK_EQ(Fraction::compare(close2, close2), 0);
+    }
+
+    TEST_CASE("Mixed denominator signs") {
+        CHECK_LT(Fraction{1, -3}, Fraction{1, 3});
+        CHECK_LT(Fraction{-1, 2}, Fraction{1, -3});
+        CHECK_GT(Fraction{-1, -2}, Fraction{1, -3});
+        CHECK_EQ(Fraction::compare(Fraction{1, -3}, Fraction{-1, 3}), 0);
+        CHECK_LT(Fraction{1, -4}, Fraction{-1, -4});
+    }
+
+    TEST_CASE("Comparing with zero does not throw") {
+        CHECK_NOTHROW((void)(Fraction{1, 2} > Fraction{0, 1}));
+        CHECK_NE(Fraction{1, 2}, Fraction{0, 1});
+    }
+
+    TEST_CASE("Sorting uses exact order") {
+        int MAXINT = std::numeric_limits<int>::max();
+        std::vector<Fraction> fracs = {Fraction{MAXINT - 1, MAXINT}, Fraction{1, 3}, Fraction{-5, 7},
+                                       Fraction{MAXINT - 2, MAXINT - 1}, Fraction{2, -9}, Fraction{1, 1}};
+        std::sort(fracs.begin(), fracs.end());
+        CHECK(std::is_sorted(fracs.begin(), fracs.end()));
+        CHECK_EQ(Fraction::compare(fracs[3], Fraction{MAXINT - 2, MAXINT - 1}), 0);
+        CHECK_EQ(Fraction::compare(fracs[4], Fraction{MAXINT - 1, MAXINT}), 0);
+        CHECK(std::binary_search(fracs.begin(), fracs.end(), Fraction{2, -9}));
+    }
+}
+
+TEST_SUITE("Lazy accumulation") {
+    TEST_CASE("Harmonic sum beyond the reach of Fraction") {
+        // H_24 = 1347822955/356948592 is the last harmonic number whose terms fit in an int
+        auto fraction_sum = [](int n) {
+            Fraction sum{0, 1};
+            for (int k = 1; k <= n; k++) {
+                sum = sum + Fraction(1, k);
+            }
+            return sum;
+        };
+        CHECK_EQ(Fraction::compare(fraction_sum(24), Fraction(1347822955, 356948592)), 0);
+        CHECK_THROWS_AS(fraction_sum(25), std::overflow_error);
+
+        FractionAccumulator acc;
+        for (int k = 1; k <= 25; k++) {
+            acc += Fraction{1, k};
+        }
+        CHECK_EQ(acc.getNumerator(), 34052522467LL);
+        CHECK_EQ(acc.getDenominator(), 8923714800LL);
+    }
+
+    TEST_CASE("Long telescoping sum") {
+        // sum of 1/(k(k+1)) for k = 1..n is n/(n+1)
+        FractionAccumulator acc;
+        const int n = 40000;
+        for (int k = 1; k <= n; k++) {
+            acc += Fraction{1, k} - Fraction{1, k + 1};
+        }
+        CHECK_EQ(acc.to_fraction(), Fraction{n, n + 1});
+    }
+
+    TEST_CASE("Mixed operations and observation") {
+        FractionAccumulator acc{Fraction{3, -4}};
+        acc -= Fraction{1, 4};
+        acc *= Fraction{-2, 3};
+        acc /= Fraction{1, -6};
+        CHECK_EQ(acc.to_fraction(), Fraction{-4, 1});
+        CHECK_THROWS_AS(acc /= Fraction(0, 1), std::runtime_error);
+
+        std::ostringstream out;
+        out << acc;
+        CHECK(out.str() == "-4/1");
+
+        CHECK_LT(acc, Fraction{-3, 1});
+        CHECK_EQ(acc, FractionAccumulator{Fraction{-8, 2}});
+    }
+
+    TEST_CASE("Results that do not fit in an int fraction") {
+        FractionAccumulator acc{Fraction{std::numeric_limits<int>::max(), 1}};
+        acc += Fraction{1, 1};
+        CHECK_EQ(acc.getNumerator(), 2147483648LL);
+        CHECK_THROWS_AS(acc.to_fraction(), std::overflow_error);
+    }
+
+    TEST_CASE("A failed operation leaves the value unchanged") {
+        // The product of the two prime denominators is just below 2^62: one more factor does not fit
+        FractionAccumulator acc{Fraction{1, 2147483647}};
+        acc += Fraction{1, 2147483629};
+        const FractionAccumulator before = acc;
+        CHECK_THROWS_AS(acc += Fraction(1, 3), std::overflow_error);
+        CHECK_THROWS_AS(acc -= Fraction(1, 3), std::overflow_error);
+        CHECK_THROWS_AS(acc *= Fraction(1, 3), std::overflow_error);
+        CHECK_THROWS_AS(acc /= Fraction(3, 1), std::overflow_error);
+        CHECK_EQ(acc, before);
+        CHECK_EQ(acc.getDenominator(), 2147483647LL * 2147483629LL);
+
+        // The accumulator is still usable
+        acc -= Fraction{1, 2147483629};
+        CHECK_EQ(acc.to_fraction(), Fraction(1, 2147483647));
+        acc += Fraction{1, 3};
+        CHECK_EQ(acc.getDenominator(), 3LL * 2147483647LL);
+    }
+}
+
+TEST_SUITE("Cross-cancellation") {
+    TEST_CASE("Products whose reduced result fits do not overflow") {
+        CHECK_EQ(Fraction(46341, 2) * Fraction(2, 46341), Fraction(1, 1));
+        CHECK_EQ(Fraction(46341, 2) / Fraction(46341, 2), Fraction(1, 1));
+        CHECK_EQ(Fraction(65536, 3) * Fraction(9, 65536), Fraction(3, 1));
+        CHECK_EQ(Fraction(-65536, 3) / Fraction(65536, -9), Fraction(3, 1));
+        CHECK_THROWS_AS(Fraction(65536, 1) * Fraction(65536, 1), std::overflow_error);
+    }
+
+    TEST_CASE("Cancelled products are fully reduced") {
+        Fraction prod = Fraction(14, 15) * Fraction(25, 28);
+        CHECK_EQ(prod.getNumerator(), 5);
+        CHECK_EQ(prod.getDenominator(), 6);
+
+        Fraction quot = Fraction(14, 15) / Fraction(28, 25);
+        CHECK_EQ(quot.getNumerator(), 5);
+        CHECK_EQ(quot.getDenominator(), 6);
+    }
+}
+
+TEST_SUITE("Fraction widths") {
+    using Fraction16 = BasicFraction<std::int16_t>;
+    using Fraction128 = BasicFraction<__int128>;
+
+    TEST_CASE("Storage is two terms of the chosen width") {
+        CHECK_EQ(sizeof(BasicFraction<std::int8_t>), 2);
+        CHECK_EQ(sizeof(Fraction16), 4);
+        CHECK_EQ(sizeof(Fraction), 8);
+        CHECK_EQ(sizeof(BasicFraction<std::int64_t>), 16);
+        CHECK_EQ(sizeof(Fraction128), 32);
+    }
+
+    TEST_CASE("16-bit fractions check their range") {
+        Fraction16 half(1, 2);
+        CHECK_EQ(half + Fraction16(1, 3), Fraction16(5, 6));
+        CHECK_EQ(Fraction16(300, 7) * Fraction16(7, 300), Fraction16(1, 1));
+        CHECK_THROWS_AS(Fraction16(200, 1) * Fraction16(200, 1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction16(32767, 1) + Fraction16(1, 1), std::overflow_error);
+        CHECK(Fraction16(32765, 32766) < Fraction16(32766, 32767));
+
+        // The scale of the precision does not fit in 8 bits, but the reduced value does
+        BasicFraction<std::int8_t> quarter(0.25f);
+        CHECK_EQ(quarter.getNumerator(), 1);
+        CHECK_EQ(quarter.getDenominator(), 4);
+    }
+
+    TEST_CASE("128-bit fractions hold products of 64-bit terms") {
+        __int128 big = static_cast<__int128>(1) << 100U;
+        Fraction128 lhs(big + 1, big);
+        Fraction128 rhs(big, big - 1);
+
+        // 1 + 1/2^100 < 1 + 1/(2^100 - 1) - compared without a wider type
+        CHECK(lhs < rhs);
+        CHECK(rhs > lhs);
+        CHECK(Fraction128(-big, 3) < Fraction128(1, big));
+        CHECK_FALSE(lhs == rhs);
+
+        Fraction128 prod = Fraction128(big, 3) * Fraction128(9, big / 2);
+        CHECK(prod == Fraction128(6, 1));
+        CHECK_THROWS_AS(Fraction128(big, 1) * Fraction128(big, 1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction128(1, big) + Fraction128(1, big - 1), std::overflow_error);
+
+        // The value is in range, but not once scaled to the precision
+        CHECK_THROWS_AS(Fraction128(1e38f), std::overflow_error);
+        CHECK_THROWS_AS(Fraction128(1e38), std::overflow_error);
+        CHECK_EQ(Fraction128(std::ldexp(1.0, 100)), Fraction128(big, 1));
+    }
+
+    TEST_CASE("Increments and decrements check their range") {
+        using Fraction8 = BasicFraction<std::int8_t>;
+        Fraction8 top(127, 1);
+        CHECK_THROWS_AS(++top, std::overflow_error);
+        CHECK_THROWS_AS(top++, std::overflow_error);
+        CHECK_EQ(top, Fraction8(127, 1));
+        Fraction8 bottom(-127, 2);
+        CHECK_THROWS_AS(--bottom, std::overflow_error);
+        CHECK_THROWS_AS(bottom--, std::overflow_error);
+        CHECK_EQ(bottom, Fraction8(-127, 2));
+        Fraction8 near(-127, 1);
+        CHECK_EQ(--near, Fraction8(-128, 1));
+        CHECK_EQ(near++, Fraction8(-128, 1));
+        CHECK_EQ(near, Fraction8(-127, 1));
+
+        Fraction max(numeric_limits<int>::max(), 1);
+        CHECK_THROWS_AS(++max, std::overflow_error);
+        CHECK_THROWS_AS(max++, std::overflow_error);
+        CHECK_EQ(max.getNumerator(), numeric_limits<int>::max());
+        Fraction min(numeric_limits<int>::min(), 1);
+        CHECK_THROWS_AS(--min, std::overflow_error);
+        CHECK_THROWS_AS(min--, std::overflow_error);
+        CHECK_EQ(min.getNumerator(), numeric_limits<int>::min());
+        Fraction half(numeric_limits<int>::max() - 2, 2);
+        CHECK_EQ(++half, Fraction(numeric_limits<int>::max(), 2));
+        CHECK_THROWS_AS(half++, std::overflow_error);
+    }
+
+    TEST_CASE("Narrow and wide terms are printed and parsed as numbers") {
+        std::ostringstream out;
+        out << BasicFraction<std::int8_t>(-3, 4) << " " << Fraction128(static_cast<__int128>(1) << 100U, 3);
+        CHECK_EQ(out.str(), "-3/4 1267650600228229401496703205376/3");
+
+        Fraction128 parsed;
+        std::istringstream in("-1267650600228229401496703205376/3");
+        in >> parsed;
+        CHECK(parsed == Fraction128(-(static_cast<__int128>(1) << 100U), 3));
+        CHECK_EQ(std::string(parsed), "-1267650600228229401496703205376/3");
+
+        BasicFraction<std::int8_t> small;
+        std::istringstream too_big("300/1");
+        CHECK_THROWS_AS(too_big >> small, std::runtime_error);
+    }
+}
+
+TEST_SUITE("Arbitrary precision") {
+    // base^exponent as a BigInt
+    BigInt power(long long int base, int exponent) {
+        BigInt result = 1;
+        for (int i = 0; i < exponent; i++) {
+            result *= base;
+        }
+        return result;
+    }
+
+    TEST_CASE("BigInt arithmetic") {
+        CHECK_EQ(power(2, 100).to_string(), "1267650600228229401496703205376");
+        CHECK_EQ(power(3, 100).to_string(), "515377520732011331036461129765621272702107522001");
+        CHECK_EQ((-power(10, 30) + 1).to_string(), "-999999999999999999999999999999");
+        CHECK_EQ(BigInt(std::numeric_limits<long long>::min()).to_int64(), std::numeric_limits<long long>::min());
+
+        BigInt a = power(3, 100) + 12345;
+        BigInt b = power(7, 20) - 1;
+        BigInt quotient;
+        BigInt remainder;
+        BigInt::divide(a, b, quotient, remainder);
+        CHECK(quotient * b + remainder == a);
+        CHECK(remainder < b);
+        CHECK(-a / b == -quotient);
+        CHECK(-a % b == -remainder);
+        CHECK_THROWS_AS(a / BigInt(), std::runtime_error);
+    }
+
+    TEST_CASE("Small values are stored inline") {
+        CHECK(BigInt(123456789).is_inline());
+        CHECK((BigInt(std::numeric_limits<int>::max()) * BigInt(std::numeric_limits<int>::max())).is_inline());
+        CHECK_FALSE(power(2, 200).is_inline());
+    }
+
+    TEST_CASE("Lehmer GCD") {
+        BigInt common = power(3, 40) * power(7, 25);
+        BigInt x = power(2, 90) * 11 + 1;
+        BigInt y = power(5, 60) + 7;
+        CHECK(BigInt::gcd(x * common, y * common) == common * BigInt::gcd(x, y));
+        CHECK(BigInt::gcd(-(x * common), y * common) == BigInt::gcd(x * common, y * common));
+        CHECK(BigInt::gcd(power(2, 300), power(6, 100)) == power(2, 100));
+        CHECK(BigInt::gcd(power(2, 300), 0) == power(2, 300));
+
+        // Consecutive Fibonacci numbers are coprime and make Euclid take the most steps
+        BigInt previous = 0;
+        BigInt current = 1;
+        for (int i = 0; i < 400; i++) {
+            BigInt next = previous + current;
+            previous = current;
+            current = next;
+        }
+        CHECK(BigInt::gcd(current, previous) == 1);
+    }
+
+    TEST_CASE("BigFraction never overflows") {
+        // H_20 overflows Fraction, but not BigFraction
+        BigFraction harmonic;
+        for (int k = 1; k <= 20; k++) {
+            harmonic += Fraction(1, k);
+        }
+        CHECK(harmonic.to_fraction() == Fraction(55835135, 15519504));
+
+        BigFraction power_ratio = 1;
+        for (int i = 0; i < 100; i++) {
+            power_ratio *= Fraction(2, 3);
+        }
+        CHECK(power_ratio.getNumerator() == power(2, 100));
+        CHECK(power_ratio.getDenominator() == power(3, 100));
+        CHECK_THROWS_AS(power_ratio.to_fraction(), std::overflow_error);
+        CHECK_EQ(power_ratio.to_double(), doctest::Approx(std::pow(2.0 / 3.0, 100)));
+
+        CHECK(power_ratio / power_ratio == BigFraction(1));
+        CHECK(power_ratio - power_ratio == BigFraction());
+        CHECK(power_ratio < BigFraction(Fraction(1, 1000)));
+        CHECK(-power_ratio < BigFraction());
+        CHECK_THROWS_AS(power_ratio / BigFraction(), std::runtime_error);
+    }
+
+    TEST_CASE("BigFraction round-trips through Fraction") {
+        Fraction negative(3, -4);
+        BigFraction big = negative;
+        CHECK(big.getDenominator() == 4);
+        CHECK(big.to_fraction() == negative);
+
+        std::ostringstream out;
+        out << big;
+        CHECK_EQ(out.str(), "-3/4");
+    }
+}
+
+TEST_SUITE("Hybrid fractions") {
+    TEST_CASE("Small values stay inline") {
+        HybridFraction sum;
+        for (int k = 1; k <= 10; k++) {
+            sum += HybridFraction(1, k);
+        }
+        CHECK(sum.is_inline());
+        CHECK(sum == HybridFraction(7381, 2520));
+        CHECK(sum.to_fraction() == Fraction(7381, 2520));
+        CHECK(HybridFraction(6, -4) == HybridFraction(Fraction(-3, 2)));
+        CHECK_THROWS_AS(HybridFraction(1, 0), std::invalid_argument);
+        CHECK_THROWS_AS(sum / HybridFraction(), std::runtime_error);
+    }
+
+    TEST_CASE("Overflow promotes instead of throwing") {
+        long long int max = std::numeric_limits<long long>::max();
+        HybridFraction huge(max, 1);
+        HybridFraction doubled = huge + huge;
+        CHECK_FALSE(doubled.is_inline());
+        CHECK(doubled > huge);
+        CHECK_THROWS_AS(doubled.to_fraction(), std::overflow_error);
+
+        // Subtracting back brings the reduced value into range, so it is demoted
+        HybridFraction back = doubled - huge;
+        CHECK(back.is_inline());
+        CHECK(back == huge);
+
+        HybridFraction tiny(1, max);
+        CHECK_FALSE((tiny * tiny).is_inline());
+        CHECK((tiny * tiny * huge).is_inline());
+        CHECK((tiny * tiny * huge) == tiny);
+        CHECK((huge / tiny).to_double() == doctest::Approx(static_cast<double>(max) * static_cast<double>(max)));
+
+        HybridFraction minimum(std::numeric_limits<long long>::min(), -1);
+        CHECK_FALSE(minimum.is_inline());
+        CHECK(minimum == huge + HybridFraction(1, 1));
+    }
+
+    TEST_CASE("H_30 stays exact") {
+        HybridFraction hybrid;
+        BigFraction big;
+        for (int k = 1; k <= 30; k++) {
+            hybrid += HybridFraction(1, k);
+            big += Fraction(1, k);
+        }
+        CHECK(hybrid.to_big() == big);
+
+        std::ostringstream hybrid_out, big_out;
+        hybrid_out << hybrid;
+        big_out << big;
+        CHECK_EQ(hybrid_out.str(), big_out.str());
+    }
+}
+
+TEST_SUITE("Fraction vectors") {
+    // Counts the elements of result that differ from op applied to each pair of elements
+    template <typename Op>
+    int count_mismatches(const FractionVector &result, const FractionVector &lhs, const FractionVector &rhs, Op op) {
+        int mismatches = 0;
+        for (size_t i = 0; i < lhs.size(); i++) {
+            Fraction expected = op(lhs[i], rhs[i]);
+            if (result.numerator_data()[i] != expected.getNumerator() ||
+                result.denominator_data()[i] != expected.getDenominator()) {
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    FractionVector random_vector(mt19937 &gen, size_t size, int bound) {
+        uniform_int_distribution<int> dist(-bound, bound);
+        FractionVector vector;
+        for (size_t i = 0; i < size; i++) {
+            int den = dist(gen);
+            vector.push_back(Fraction(dist(gen), den == 0 ? 1 : den));
+        }
+        return vector;
+    }
+
+    TEST_CASE("Every instruction set matches Fraction") {
+        mt19937 gen(2023);
+        const simd::Isa isas[] = {simd::Isa::Scalar, simd::Isa::SSE4, simd::Isa::AVX2};
+        for (simd::Isa isa : isas) {
+            simd::set_isa(isa);
+            CHECK(static_cast<int>(simd::active_isa()) <= static_cast<int>(simd::best_isa()));
+
+            // An odd size leaves a tail for the scalar kernel
+            FractionVector lhs = random_vector(gen, 1001, 30000);
+            FractionVector rhs = random_vector(gen, 1001, 30000);
+            CHECK_EQ(count_mismatches(lhs + rhs, lhs, rhs, [](const Fraction &a, const Fraction &b) { return a + b; }), 0);
+            CHECK_EQ(count_mismatches(lhs - rhs, lhs, rhs, [](const Fraction &a, const Fraction &b) { return a - b; }), 0);
+
+            FractionVector big_lhs = random_vector(gen, 1001, numeric_limits<int>::max());
+            FractionVector big_rhs = random_vector(gen, 1001, numeric_limits<int>::max());
+            for (size_t i = 0; i < big_rhs.size(); i++) {
+                if (big_rhs[i].getNumerator() == 0) {
+                    big_rhs.set(i, Fraction(1, 1));
+                }
+            }
+            // Reciprocals cancel completely, so the large products stay in range
+            FractionVector reciprocals;
+            for (size_t i = 0; i < big_rhs.size(); i++) {
+                reciprocals.push_back(Fraction(big_rhs[i].getDenominator(), big_rhs[i].getNumerator()));
+            }
+            CHECK_EQ(count_mismatches(reciprocals * big_rhs, reciprocals, big_rhs, [](const Fraction &a, const Fraction &b) { return a * b; }), 0);
+            CHECK_EQ(count_mismatches(big_rhs / big_rhs, big_rhs, big_rhs, [](const Fraction &a, const Fraction &b) { return a / b; }), 0);
+            CHECK_EQ(count_mismatches(lhs * rhs, lhs, rhs, [](const Fraction &a, const Fraction &b) { return a * b; }), 0);
+            CHECK_EQ(count_mismatches(lhs / rhs, lhs, rhs, [](const Fraction &a, const Fraction &b) { return a / b; }), 0);
+
+            vector<int> order = FractionVector::compare(big_lhs, big_rhs);
+            int wrong_order = 0;
+            for (size_t i = 0; i < order.size(); i++) {
+                int expected = big_lhs[i] < big_rhs[i] ? -1 : (big_rhs[i] < big_lhs[i] ? 1 : 0);
+                if (order[i] != expected) {
+                    wrong_order++;
+                }
+            }
+            CHECK_EQ(wrong_order, 0);
+        }
+        simd::set_isa(simd::best_isa());
+    }
+
+    TEST_CASE("Errors match Fraction") {
+        const simd::Isa isas[] = {simd::Isa::Scalar, simd::Isa::SSE4, simd::Isa::AVX2};
+        for (simd::Isa isa : isas) {
+            simd::set_isa(isa);
+            int max = numeric_limits<int>::max();
+            FractionVector lhs(17);
+            FractionVector rhs(17);
+            CHECK_THROWS_AS(lhs / rhs, std::runtime_error);
+            CHECK_THROWS_AS(lhs + FractionVector(16), std::invalid_argument);
+
+            // One overflowing element, in the vector part and in the tail
+            for (size_t index : {size_t(3), size_t(16)}) {
+                FractionVector overflowing(17);
+                overflowing.set(index, Fraction(max, 1));
+                CHECK_THROWS_AS(overflowing + overflowing, std::overflow_error);
+                CHECK_THROWS_AS(overflowing * overflowing, std::overflow_error);
+                FractionVector tiny(17);
+                tiny.set(index, Fraction(1, max - 1));
+                CHECK_THROWS_AS(tiny * tiny, std::overflow_error);
+            }
+
+            FractionVector minimum{Fraction(numeric_limits<int>::min(), 1), Fraction(1, 2)};
+            FractionVector quotient = minimum / minimum;
+            CHECK(quotient[0] == Fraction(1, 1));
+            CHECK(quotient[1] == Fraction(1, 1));
+        }
+        simd::set_isa(simd::best_isa());
+        CHECK_THROWS_AS(FractionVector{Fraction(1, numeric_limits<int>::min())}, std::overflow_error);
+    }
+}
+
+TEST_SUITE("Formatting") {
+    template <typename IntT>
+    string formatted(const BasicFraction<IntT> &fraction) {
+        char buffer[BasicFraction<IntT>::max_chars];
+        return string(buffer, fraction.format_to(buffer));
+    }
+
+    TEST_CASE("format_to moves the sign to the numerator") {
+        CHECK_EQ(formatted(Fraction(3, 4)), "3/4");
+        CHECK_EQ(formatted(Fraction(3, -4)), "-3/4");
+        CHECK_EQ(formatted(Fraction(-3, -4)), "3/4");
+        CHECK_EQ(formatted(Fraction(0, -7)), "0/1");
+        CHECK_EQ(formatted(Fraction(-6, 4)), "-3/2");
+    }
+
+    TEST_CASE("format_to fills the buffer at every width") {
+        int max = numeric_limits<int>::max();
+        CHECK_EQ(formatted(Fraction(numeric_limits<int>::min(), max)), "-2147483648/2147483647");
+        CHECK_EQ(Fraction::max_chars, 22);
+
+        using Fraction8 = BasicFraction<int8_t>;
+        CHECK_EQ(formatted(Fraction8(-128, 127)), "-128/127");
+        CHECK_EQ(Fraction8::max_chars, 8);
+
+        using Fraction64 = BasicFraction<int64_t>;
+        int64_t max64 = numeric_limits<int64_t>::max();
+        CHECK_EQ(formatted(Fraction64(max64, -(max64 - 1))), "-9223372036854775807/9223372036854775806");
+
+        using Fraction128 = BasicFraction<__int128>;
+        __int128 min128 = FractionTraits<__int128>::min_value;
+        __int128 max128 = FractionTraits<__int128>::max_value;
+        string expected = "-170141183460469231731687303715884105728/170141183460469231731687303715884105727";
+        CHECK_EQ(formatted(Fraction128(min128, max128)), expected);
+        CHECK_EQ(expected.size(), Fraction128::max_chars);
+    }
+
+    TEST_CASE("operator<< writes the same text") {
+        ostringstream out;
+        out << Fraction(5, -10) << ' ' << Fraction(7, 3) << ' ' << BasicFraction<int16_t>(-300, 400);
+        CHECK_EQ(out.str(), "-1/2 7/3 -3/4");
+    }
+}
+
+TEST_SUITE("Fraction parser") {
+    TEST_CASE("Both forms the stream operator accepts") {
+        Fraction fraction;
+        CHECK(parse_fraction("3/4", fraction).error == ParseError::None);
+        CHECK_EQ(fraction, Fraction(3, 4));
+        CHECK(parse_fraction("  -6 8\n", fraction).error == ParseError::None);
+        CHECK_EQ(fraction, Fraction(-3, 4));
+        CHECK(parse_fraction("+5/ -10", fraction).error == ParseError::None);
+        CHECK_EQ(fraction, Fraction(-1, 2));
+        CHECK(parse_fraction("-2147483648/1", fraction).error == ParseError::None);
+        CHECK_EQ(fraction.getNumerator(), numeric_limits<int>::min());
+
+        // The parser agrees with operator>>
+        istringstream in("12 -18");
+        Fraction streamed;
+        in >> streamed;
+        CHECK(parse_fraction("12 -18", fraction).error == ParseError::None);
+        CHECK_EQ(fraction.getNumerator(), streamed.getNumerator());
+        CHECK_EQ(fraction.getDenominator(), streamed.getDenominator());
+    }
+
+    TEST_CASE("Errors are reported by code and position") {
+        Fraction fraction(1, 3);
+        string_view text = "7/0";
+        ParseResult result = parse_fraction(text, fraction);
+        CHECK(result.error == ParseError::ZeroDenominator);
+        CHECK_EQ(result.ptr - text.data(), 2);
+        CHECK_EQ(fraction, Fraction(1, 3));
+
+        CHECK(parse_fraction("", fraction).error == ParseError::InvalidNumber);
+        CHECK(parse_fraction("3", fraction).error == ParseError::InvalidNumber);
+        CHECK(parse_fraction("3/", fraction).error == ParseError::InvalidNumber);
+        CHECK(parse_fraction("a/4", fraction).error == ParseError::InvalidNumber);
+        CHECK(parse_fraction("3x4", fraction).error == ParseError::InvalidNumber);
+        CHECK(parse_fraction("3/4/5", fraction).error == ParseError::TrailingInput);
+        CHECK(parse_fraction("2147483648/1", fraction).error == ParseError::OutOfRange);
+        CHECK(parse_fraction("1/-2147483649", fraction).error == ParseError::OutOfRange);
+        CHECK(parse_fraction("1/-2147483648", fraction).error == ParseError::OutOfRange);
+        CHECK_EQ(fraction, Fraction(1, 3));
+    }
+
+    TEST_CASE("Bulk parsing stops at the first error") {
+        string text = "1/2 3 4\n-5/10\r\n  7/8\n";
+        vector<Fraction> fractions;
+        ParseResult result = parse_fractions(text.data(), text.data() + text.size(), back_inserter(fractions));
+        CHECK(result.error == ParseError::None);
+        CHECK_EQ(result.ptr, text.data() + text.size());
+        REQUIRE_EQ(fractions.size(), 4);
+        CHECK_EQ(fractions[1], Fraction(3, 4));
+        CHECK_EQ(fractions[2], Fraction(-1, 2));
+
+        text = "1/2 3/0 5/6";
+        fractions.clear();
+        result = parse_fractions(text.data(), text.data() + text.size(), back_inserter(fractions));
+        CHECK(result.error == ParseError::ZeroDenominator);
+        CHECK_EQ(result.ptr - text.data(), 6);
+        CHECK_EQ(fractions.size(), 1);
+    }
+}
+
+TEST_SUITE("Fraction files") {
+    // Lines of random fractions, as operator<< writes them
+    string fraction_lines(size_t count, vector<Fraction> &expected) {
+        mt19937 gen(77);
+        uniform_int_distribution<int> dist(-100000, 100000);
+        ostringstream out;
+        for (size_t i = 0; i < count; i++) {
+            int den = dist(gen);
+            expected.push_back(Fraction(dist(gen), den == 0 ? 1 : den));
+            out << expected.back() << '\n';
+        }
+        return out.str();
+    }
+
+    bool same_value(const Fraction &lhs, const Fraction &rhs) {
+        return Fraction::compare(lhs, rhs) == 0;
+    }
+
+    TEST_CASE("Chunks are joined in order") {
+        vector<Fraction> expected;
+        string text = fraction_lines(50000, expected);
+        for (unsigned int threads : {1U, 3U, 8U}) {
+            vector<Fraction> parsed = parse_fractions_parallel(text.data(), text.data() + text.size(), threads);
+            REQUIRE_EQ(parsed.size(), expected.size());
+            CHECK(equal(parsed.begin(), parsed.end(), expected.begin(), same_value));
+        }
+        CHECK(parse_fractions_parallel(text.data(), text.data(), 4).empty());
+    }
+
+    TEST_CASE("Errors name the line") {
+        vector<Fraction> expected;
+        string text = fraction_lines(40000, expected) + "1/0\n" + fraction_lines(40000, expected);
+        CHECK_THROWS_WITH_AS(parse_fractions_parallel(text.data(), text.data() + text.size(), 4),
+                             "Invalid input on line 40001: zero denominator", std::invalid_argument);
+
+        // Terms in range whose reduced fraction is not are reported by the worker, not fatal to it
+        text = fraction_lines(40000, expected) + "1/-2147483648\n" + fraction_lines(40000, expected);
+        CHECK_THROWS_WITH_AS(parse_fractions_parallel(text.data(), text.data() + text.size(), 4),
+                             "Invalid input on line 40001: out of range", std::invalid_argument);
+    }
+
+    TEST_CASE("Fractions end at their line") {
+        // "a b" terms are separated by spaces and tabs only; blank lines and CRLF endings are allowed
+        string text = " 1/2\n3\t 4\r\n\n-5 10 \n";
+        vector<Fraction> fractions;
+        ParseResult result = parse_fraction_lines(text.data(), text.data() + text.size(), back_inserter(fractions));
+        CHECK(result.error == ParseError::None);
+        REQUIRE_EQ(fractions.size(), 3);
+        CHECK(same_value(fractions[1], Fraction(3, 4)));
+        CHECK(same_value(fractions[2], Fraction(-1, 2)));
+
+        text = "1/2\n7\n3\n";
+        result = parse_fraction_lines(text.data(), text.data() + text.size(), back_inserter(fractions));
+        CHECK(result.error == ParseError::InvalidNumber);
+        CHECK_EQ(result.ptr - text.data(), 5);
+        text = "1/2 3/4\n";
+        result = parse_fraction_lines(text.data(), text.data() + text.size(), back_inserter(fractions));
+        CHECK(result.error == ParseError::TrailingInput);
+    }
+
+    TEST_CASE("The result does not depend on the threads") {
+        // A line that is only a numerator, at the cut between two chunks
+        vector<Fraction> expected;
+        string head = fraction_lines(32866, expected);
+        string text = head + "7\n3\n" + fraction_lines(32866, expected);
+        const char *cut = text.data() + text.size() / 2;
+        CHECK(std::abs(cut - (text.data() + head.size())) < 16);
+        for (unsigned int threads : {1U, 2U, 5U}) {
+            CHECK_THROWS_WITH_AS(parse_fractions_parallel(text.data(), text.data() + text.size(), threads),
+                                 "Invalid input on line 32867: invalid fraction", std::invalid_argument);
+        }
+
+        // Valid text, in both forms and with CRLF endings, parses the same under any number of threads
+        text = head;
+        for (char &character : text) {
+            if (character == '/') {
+                character = ' ';
+            }
+        }
+        text += "\r\n\n" + head;
+        vector<Fraction> single = parse_fractions_parallel(text.data(), text.data() + text.size(), 1);
+        REQUIRE_EQ(single.size(), 2 * 32866);
+        for (unsigned int threads : {2U, 3U, 8U}) {
+            vector<Fraction> parsed = parse_fractions_parallel(text.data(), text.data() + text.size(), threads);
+            REQUIRE_EQ(parsed.size(), single.size());
+            CHECK(equal(parsed.begin(), parsed.end(), single.begin(), same_value));
+        }
+    }
+
+    TEST_CASE("Files are mapped and loaded") {
+        auto path = filesystem::temp_directory_path() / "fraction_file_test.txt";
+        vector<Fraction> expected;
+        {
+            ofstream file(path);
+            file << fraction_lines(1000, expected);
+        }
+        vector<Fraction> loaded = load_fractions(path.string(), 2);
+        REQUIRE_EQ(loaded.size(), expected.size());
+        CHECK(equal(loaded.begin(), loaded.end(), expected.begin(), same_value));
+
+        FractionVector vector = load_fraction_vector(path.string());
+        REQUIRE_EQ(vector.size(), expected.size());
+        CHECK_EQ(vector[999], expected[999]);
+
+        {
+            ofstream file(path, ios::trunc);
+        }
+        CHECK(load_fractions(path.string()).empty());
+        filesystem::remove(path);
+        CHECK_THROWS_AS(load_fractions(path.string()), std::system_error);
+    }
+}
+
+TEST_SUITE("Binary format") {
+    vector<Fraction> sample_fractions() {
+        int max = numeric_limits<int>::max();
+        return {Fraction(1, 2), Fraction(3, -4), Fraction(0, 5), Fraction(-max, max - 1),
+                Fraction(numeric_limits<int>::min(), 3), Fraction(7, 1)};
+    }
+
+    bool same_fractions(const vector<Fraction> &lhs, const vector<Fraction> &rhs) {
+        return lhs.size() == rhs.size() && equal(lhs.begin(), lhs.end(), rhs.begin(),
+            [](const Fraction &a, const Fraction &b) { return Fraction::compare(a, b) == 0; });
+    }
+
+    TEST_CASE("Both encodings round-trip") {
+        vector<Fraction> fractions = sample_fractions();
+        vector<char> fixed = binary::encode(fractions, binary::Encoding::Fixed);
+        CHECK_EQ(fixed.size(), binary::HEADER_SIZE + fractions.size() * binary::FIXED_SIZE);
+        CHECK(same_fractions(binary::decode(fixed.data(), fixed.size()), fractions));
+
+        vector<char> varint = binary::encode(fractions, binary::Encoding::Varint);
+        CHECK(varint.size() < fixed.size());
+        CHECK(same_fractions(binary::decode(varint.data(), varint.size()), fractions));
+
+        // Small values take a byte per term
+        vector<char> small = binary::encode({Fraction(-1, 2), Fraction(3, 4)}, binary::Encoding::Varint);
+        CHECK_EQ(small.size(), binary::HEADER_SIZE + 4);
+
+        stringstream stream;
+        binary::write(stream, fractions, binary::Encoding::Varint);
+        CHECK(same_fractions(binary::read(stream), fractions));
+    }
+
+    TEST_CASE("The fixed layout is little-endian with the sign on the numerator") {
+        vector<char> bytes = binary::encode({Fraction(3, -4)});
+        REQUIRE_EQ(bytes.size(), 24);
+        CHECK_EQ(string(bytes.data(), 4), "FRAC");
+        CHECK_EQ(bytes[4], binary::VERSION);
+        CHECK_EQ(bytes[8], 1);
+        CHECK_EQ(static_cast<unsigned char>(bytes[16]), 0xFD);
+        CHECK_EQ(static_cast<unsigned char>(bytes[19]), 0xFF);
+        CHECK_EQ(bytes[20], 4);
+    }
+
+    TEST_CASE("A view reads a mapped file in place") {
+        auto path = (filesystem::temp_directory_path() / "fraction_binary_test.bin").string();
+        vector<Fraction> fractions = sample_fractions();
+        binary::save(path, fractions);
+        CHECK(same_fractions(binary::load(path), fractions));
+        {
+            MappedFile file(path);
+            binary::FractionView view(file.data(), file.size());
+            REQUIRE_EQ(view.size(), fractions.size());
+            CHECK_EQ(view.numerator(1), -3);
+            CHECK_EQ(view.denominator(1), 4);
+            CHECK_EQ(view[3], fractions[3]);
+        }
+        binary::save(path, fractions, binary::Encoding::Varint);
+        CHECK(same_fractions(binary::load(path), fractions));
+        MappedFile file(path);
+        CHECK_THROWS_AS(binary::FractionView(file.data(), file.size()), std::invalid_argument);
+        filesystem::remove(path);
+    }
+
+    TEST_CASE("Corrupt input is rejected") {
+        vector<char> bytes = binary::encode(sample_fractions(), binary::Encoding::Varint);
+        CHECK_THROWS_AS(binary::decode(bytes.data(), 10), std::invalid_argument);
+        CHECK_THROWS_AS(binary::decode(bytes.data(), bytes.size() - 1), std::invalid_argument);
+
+        vector<char> other_version = bytes;
+        other_version[4] = 2;
+        CHECK_THROWS_AS(binary::decode(other_version.data(), other_version.size()), std::invalid_argument);
+
+        vector<char> fixed = binary::encode({Fraction(1, 2)});
+        fixed[20] = 0;
+        CHECK_THROWS_AS(binary::decode(fixed.data(), fixed.size()), std::invalid_argument);
+        CHECK_THROWS_AS(binary::FractionView(fixed.data(), fixed.size() - 1), std::invalid_argument);
+    }
+}
+
+TEST_SUITE("Floating-point conversion") {
+    template <typename IntT>
+    bool has_terms(const BasicFraction<IntT> &fraction, long long num, long long den) {
+        return fraction.getNumerator() == num && fraction.getDenominator() == den;
+    }
+
+    TEST_CASE("Exact conversion keeps every bit") {
+        CHECK(has_terms(Fraction::from_double(0.375, FloatConversion::Exact), 3, 8));
+        CHECK(has_terms(Fraction::from_double(-2.5, FloatConversion::Exact), -5, 2));
+        CHECK(has_terms(Fraction::from_double(0.0, FloatConversion::Exact), 0, 1));
+        CHECK(has_terms(Fraction::from_double(1e9, FloatConversion::Exact), 1000000000, 1));
+        CHECK(has_terms(Fraction::from_double(static_cast<double>(0.1F), FloatConversion::Exact), 13421773, 134217728));
+        CHECK_THROWS_AS(Fraction::from_double(0.1, FloatConversion::Exact), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double(3e9, FloatConversion::Exact), std::overflow_error);
+
+        // The minimum int is a numerator; its negation is not
+        CHECK(has_terms(Fraction::from_double(-2147483648.0, FloatConversion::Exact), numeric_limits<int>::min(), 1));
+        CHECK_THROWS_AS(Fraction::from_double(2147483648.0, FloatConversion::Exact), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double(-2147483649.0, FloatConversion::Exact), std::overflow_error);
+
+        using Fraction64 = BasicFraction<int64_t>;
+        CHECK(has_terms(Fraction64::from_double(0.1, FloatConversion::Exact), 3602879701896397LL, 36028797018963968LL));
+        CHECK(has_terms(Fraction64::from_double(-0.1, FloatConversion::Exact), -3602879701896397LL, 36028797018963968LL));
+    }
+
+    TEST_CASE("Best rational approximation") {
+        const double pi = 3.14159265358979323846;
+        CHECK(has_terms(Fraction::from_double(pi, FloatConversion::Approximate, 1000), 355, 113));
+        CHECK(has_terms(Fraction::from_double(pi, FloatConversion::Approximate, 100), 311, 99));
+        CHECK(has_terms(Fraction::from_double(pi, FloatConversion::Approximate, 7), 22, 7));
+        CHECK(has_terms(Fraction::from_double(-pi, FloatConversion::Approximate, 1), -3, 1));
+        CHECK(has_terms(Fraction::from_double(sqrt(2.0), FloatConversion::Approximate, 1000), 1393, 985));
+        CHECK(has_terms(Fraction::from_double(0.1, FloatConversion::Approximate), 1, 10));
+        CHECK(has_terms(Fraction::from_double(1.0 / 3.0, FloatConversion::Approximate), 1, 3));
+        CHECK(has_terms(Fraction::from_double(2.7, FloatConversion::Approximate, 1), 3, 1));
+        CHECK(has_terms(Fraction::from_double(1e-30, FloatConversion::Approximate), 0, 1));
+        CHECK(has_terms(Fraction::from_double(0.0004, FloatConversion::Approximate, 1000), 0, 1));
+        CHECK(has_terms(Fraction::from_double(0.0006, FloatConversion::Approximate, 1000), 1, 1000));
+
+        // Numerators are bounded too: 333/106 is the next convergent of pi, but 333 does not fit in int8_t
+        CHECK(has_terms(BasicFraction<int8_t>::from_double(pi, FloatConversion::Approximate), 22, 7));
+
+        CHECK_THROWS_AS(Fraction::from_double(3e9, FloatConversion::Approximate), std::overflow_error);
+        CHECK(has_terms(Fraction::from_double(-2147483648.0, FloatConversion::Approximate), numeric_limits<int>::min(), 1));
+        CHECK(has_terms(BasicFraction<int8_t>::from_double(-128.0, FloatConversion::Approximate), -128, 1));
+        CHECK_THROWS_AS(BasicFraction<int8_t>::from_double(128.0, FloatConversion::Approximate), std::overflow_error);
+        CHECK_THROWS_AS(Fraction::from_double(0.5, FloatConversion::Approximate, 0), std::invalid_argument);
+        CHECK_THROWS_AS(Fraction::from_double(numeric_limits<double>::quiet_NaN(), FloatConversion::Exact), std::runtime_error);
+    }
+
+    TEST_CASE("Truncate matches the constructor") {
+        CHECK(has_terms(Fraction::from_double(0.3333, FloatConversion::Truncate), 333, 1000));
+        CHECK_EQ(Fraction::from_double(-1.25, FloatConversion::Truncate), Fraction(-1.25));
+    }
+}
+
+TEST_SUITE("Decimal precision") {
+    template <typename IntT, typename Precision>
+    bool has_terms(const BasicFraction<IntT, Precision> &fraction, long long num, long long den) {
+        return fraction.getNumerator() == num && fraction.getDenominator() == den;
+    }
+
+    using Fraction2 = DecimalFraction<2>;
+    using Fraction6 = DecimalFraction<6>;
+
+    TEST_CASE("The scale is a compile-time power of ten") {
+        static_assert(DecimalPrecision<0>::scale == 1);
+        static_assert(DecimalPrecision<2>::scale == 100);
+        static_assert(DecimalPrecision<9>::scale == 1000000000);
+        static_assert(std::is_same_v<Fraction, DecimalFraction<3>>);
+        CHECK_EQ(FACTOR, 1000);
+    }
+
+    TEST_CASE("Float constructors truncate to the precision") {
+        CHECK(has_terms(Fraction(0.3333f), 333, 1000));
+        CHECK(has_terms(Fraction2(0.3333f), 33, 100));
+        CHECK(has_terms(Fraction2(-0.789), -39, 50));
+        CHECK(has_terms(Fraction6(0.125), 1, 8));
+        CHECK(has_terms(Fraction6(0.1234567), 123456, 1000000) == false);
+        CHECK(has_terms(Fraction6(0.1234567), 1929, 15625));
+    }
+
+    TEST_CASE("Mixed float arithmetic is exact on the converted float") {
+        CHECK(has_terms(Fraction2(1, 3) + 0.5f, 5, 6));
+        CHECK(has_terms(0.5f + Fraction2(1, 3), 5, 6));
+        CHECK(has_terms(Fraction2(1, 3) - 0.5f, -1, 6));
+        CHECK(has_terms(1.0f - Fraction2(1, 3), 2, 3));
+        CHECK(has_terms(Fraction2(1, 3) / 2.0f, 1, 6));
+        CHECK(has_terms(2.0f / Fraction2(1, 3), 6, 1));
+
+        // The float is rounded to the precision, halves away from zero, before the exact operation
+        CHECK(has_terms(Fraction2(1, 3) + 0.125f, 139, 300));
+        CHECK(has_terms(Fraction6(1, 3) + 0.125f, 11, 24));
+        CHECK(has_terms(Fraction2(1, 3) * 0.125f, 13, 300));
+        CHECK(has_terms(0.125f * Fraction6(1, 3), 1, 24));
+        CHECK(has_terms(Fraction2(0, 1) + 0.125f, 13, 100));
+        CHECK(has_terms(Fraction2(0, 1) - 0.125f, -13, 100));
+    }
+
+    TEST_CASE("Float error does not accumulate") {
+        Fraction sum(0, 1);
+        for (int i = 0; i < 10; ++i) {
+            sum = sum + 0.1f;
+        }
+        CHECK(has_terms(sum, 1, 1));
+
+        Fraction6 tenths(0, 1);
+        for (int i = 0; i < 1000; ++i) {
+            tenths += 0.1f;
+        }
+        CHECK(has_terms(tenths, 100, 1));
+    }
+
+    TEST_CASE("Float equality agrees up to the precision") {
+        Fraction2 third2(1, 3);
+        Fraction6 third6(1, 3);
+        CHECK(third2 == 0.33f);
+        CHECK_FALSE(third6 == 0.33f);
+        CHECK(third6 == 0.333333f);
+
+        // Both argument orders compare the same way
+        CHECK(0.33f == third2);
+        CHECK_FALSE(0.33f != third2);
+        CHECK_FALSE(0.33f == third6);
+        CHECK(0.333333f == third6);
+        CHECK_EQ(0.5f < third2, third2 > 0.5f);
+        CHECK_EQ(0.3f > third2, third2 < 0.3f);
+        CHECK_EQ(0.33f >= third2, third2 <= 0.33f);
+        CHECK_EQ(0.34f <= third2, third2 >= 0.34f);
+
+        // Fractions are compared exactly at any precision
+        CHECK_NE(Fraction2(1, 3), Fraction2(33, 100));
+        CHECK_NE(Fraction6(1, 3), Fraction6(33, 100));
+        CHECK_EQ(Fraction2(33, 100), Fraction2(66, 200));
+    }
+
+    TEST_CASE("Float operands are checked") {
+        CHECK_THROWS_AS(Fraction(1, 2) + numeric_limits<float>::quiet_NaN(), std::runtime_error);
+        CHECK_THROWS_AS(Fraction(1, 2) + 1e10f, std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 2) / 0.0001f, std::runtime_error);
+        CHECK_THROWS_AS(Fraction2(1, 2) / 0.004f, std::runtime_error);
+        CHECK(has_terms(Fraction6(1, 2) / 0.004f, 125, 1));
+
+        // 123457/1000000 + 1/3001 needs a denominator of 3001000000, past the range of int
+        CHECK_THROWS_AS(Fraction6(1, 3001) + 0.1234567f, std::overflow_error);
+        CHECK(has_terms(Fraction2(1, 3001) + 0.1234567f, 9028, 75025));
+    }
+
+    // Counts the mixed results that differ from the fraction operators on the float as an exact fraction
+    template <typename Decimal>
+    int count_mixed_mismatches(int steps, int bound) {
+        mt19937 gen(2018);
+        uniform_int_distribution<int> num_dist(-5000, 5000);
+        uniform_int_distribution<int> den_dist(1, 5000);
+        uniform_int_distribution<int> step_dist(-bound, bound);
+        int mismatches = 0;
+        for (int i = 0; i < 5000; i++) {
+            Decimal lhs(num_dist(gen), den_dist(gen));
+            int step = step_dist(gen);
+            // step / steps is exact in float and at the precision, and so is its product by the scale
+            float value = static_cast<float>(step) / static_cast<float>(steps);
+            Decimal exact(step, steps);
+            mismatches += Decimal::compare(lhs + value, lhs + exact) != 0;
+            mismatches += Decimal::compare(lhs - value, lhs - exact) != 0;
+            mismatches += Decimal::compare(value + lhs, exact + lhs) != 0;
+            mismatches += Decimal::compare(value - lhs, exact - lhs) != 0;
+            if (step != 0) {
+                mismatches += Decimal::compare(lhs / value, lhs / exact) != 0;
+            }
+        }
+        return mismatches;
+    }
+
+    TEST_CASE("Mixed operators match the exact fraction operators") {
+        CHECK_EQ(count_mixed_mismatches<Fraction>(8, 4000), 0);
+        CHECK_EQ(count_mixed_mismatches<Fraction2>(4, 4000), 0);
+        CHECK_EQ(count_mixed_mismatches<Fraction6>(64, 1000), 0);
+        CHECK_EQ(count_mixed_mismatches<BasicFraction<std::int64_t>>(8, 4000), 0);
+
+        // Results that do not fit still throw, whether or not the wide terms overflow
+        CHECK_THROWS_AS(Fraction(1, numeric_limits<int>::max()) + 2e9f, std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 3000001) - 0.001f, std::overflow_error);
+        CHECK_THROWS_AS(Fraction(numeric_limits<int>::max(), 7) / 0.125f, std::overflow_error);
+        CHECK(has_terms(Fraction(-7, 3) / -0.125f, 56, 3));
+        CHECK(has_terms(0.25f - Fraction(1, 4), 0, 1));
+    }
+}
+
+TEST_SUITE("Hashing") {
+    TEST_CASE("Equal fractions hash alike") {
+        std::hash<Fraction> hasher;
+        CHECK_EQ(hasher(Fraction(3, -4)), hasher(Fraction(-3, 4)));
+        CHECK_EQ(hasher(Fraction(2, 4)), hasher(Fraction(1, 2)));
+        CHECK_NE(hasher(Fraction(1, 2)), hasher(Fraction(2, 1)));
+        CHECK_NE(hasher(Fraction(1, 2)), hasher(Fraction(-1, 2)));
+        CHECK_EQ(std::hash<BasicFraction<int64_t>>()(BasicFraction<int64_t>(5, -7)),
+                 std::hash<BasicFraction<int64_t>>()(BasicFraction<int64_t>(-5, 7)));
+
+        // Keys are compared exactly, as operator== compares
+        CHECK_FALSE(Fraction(1, 3) == Fraction(333, 1000));
+        CHECK_FALSE(std::equal_to<Fraction>()(Fraction(1, 3), Fraction(333, 1000)));
+        CHECK(std::equal_to<Fraction>()(Fraction(3, -4), Fraction(-3, 4)));
+    }
+
+    TEST_CASE("Standard unordered containers") {
+        std::unordered_set<Fraction> set;
+        for (int den = 1; den <= 12; ++den) {
+            for (int num = -12; num <= 12; ++num) {
+                set.insert(Fraction(num, den));
+                set.insert(Fraction(-num, -den));
+            }
+        }
+
+        // The distinct values of num/den are counted by reducing each pair
+        std::set<std::pair<int, int>> reduced;
+        for (int den = 1; den <= 12; ++den) {
+            for (int num = -12; num <= 12; ++num) {
+                int common = std::gcd(num, den);
+                reduced.insert({num / common, den / common});
+            }
+        }
+        CHECK_EQ(set.size(), reduced.size());
+        CHECK_EQ(set.count(Fraction(6, -8)), 1);
+        CHECK_EQ(set.count(Fraction(333, 1000)), 0);
+    }
+
+    TEST_CASE("FractionHashMap counts and finds") {
+        FractionHashMap<int> counts;
+        CHECK(counts.empty());
+        CHECK(counts.find(Fraction(1, 2)) == nullptr);
+        CHECK_FALSE(counts.erase(Fraction(1, 2)));
+
+        counts[Fraction(1, 2)] += 1;
+        counts[Fraction(2, 4)] += 1;
+        counts[Fraction(-1, -2)] += 1;
+        counts[Fraction(3, -4)] += 1;
+        CHECK_EQ(counts.size(), 2);
+        CHECK_EQ(*counts.find(Fraction(1, 2)), 3);
+        CHECK_EQ(*counts.find(Fraction(-3, 4)), 1);
+        CHECK_FALSE(counts.contains(Fraction(333, 1000)));
+
+        auto inserted = counts.insert(Fraction(1, 2), 10);
+        CHECK_FALSE(inserted.second);
+        CHECK_EQ(*inserted.first, 3);
+        CHECK(counts.insert(Fraction(5, 1), 10).second);
+
+        int total = 0;
+        counts.for_each([&total](const Fraction &, int count) { total += count; });
+        CHECK_EQ(total, 14);
+
+        CHECK(counts.erase(Fraction(2, 4)));
+        CHECK_FALSE(counts.contains(Fraction(1, 2)));
+        CHECK_EQ(counts.size(), 2);
+        counts.clear();
+        CHECK(counts.empty());
+        CHECK_FALSE(counts.contains(Fraction(5, 1)));
+    }
+
+    TEST_CASE("FractionHashMap matches std::map under random inserts and erases") {
+        std::mt19937 gen(2024);
+        std::uniform_int_distribution<int> term(-40, 40);
+        std::uniform_int_distribution<int> action(0, 2);
+        FractionHashMap<int> map;
+        std::map<std::pair<int, int>, int> reference;
+        bool consistent = true;
+        for (int i = 0; i < 20000; ++i) {
+            int den = term(gen);
+            Fraction key(term(gen), den == 0 ? 1 : den);
+            auto terms = hashing::canonical(key);
+            std::pair<int, int> plain{static_cast<int>(terms.numerator), static_cast<int>(terms.denominator)};
+            if (action(gen) == 0) {
+                consistent = consistent && map.erase(key) == (reference.erase(plain) == 1);
+            }
+            else {
+                map[key] += i;
+                reference[plain] += i;
+            }
+            const int *value = map.find(key);
+            auto found = reference.find(plain);
+            consistent = consistent && (value == nullptr) == (found == reference.end());
+            consistent = consistent && (value == nullptr || *value == found->second);
+        }
+        CHECK(consistent);
+        CHECK_EQ(map.size(), reference.size());
+
+        std::size_t visited = 0;
+        map.for_each([&](const Fraction &key, int value) {
+            auto terms = hashing::canonical(key);
+            auto found = reference.find({static_cast<int>(terms.numerator), static_cast<int>(terms.denominator)});
+            visited += found != reference.end() && found->second == value ? 1U : 0U;
+        });
+        CHECK_EQ(visited, reference.size());
+    }
+
+    TEST_CASE("FractionHashMap with 64-bit keys") {
+        using Fraction64 = BasicFraction<int64_t>;
+        FractionHashMap<std::string, Fraction64> names(100);
+        names[Fraction64(1, 3)] = "third";
+        names[Fraction64(4000000000LL, 3)] = "large";
+        CHECK_EQ(*names.find(Fraction64(-2, -6)), "third");
+        CHECK_EQ(*names.find(Fraction64(-4000000000LL, -3)), "large");
+        CHECK_EQ(names.size(), 2);
+    }
+}
+
+TEST_SUITE("Fraction pool") {
+    TEST_CASE("Equal fractions share a handle") {
+        FractionPool pool;
+        auto half = pool.intern(1, 2);
+        CHECK(pool.intern(2, 4) == half);
+        CHECK(pool.intern(-1, -2) == half);
+        CHECK(pool.intern(Fraction(32, 64)) == half);
+        CHECK(pool.intern(3, -4) == pool.intern(-3, 4));
+        CHECK(pool.intern(0, 7) == pool.intern(0, 1));
+        CHECK_FALSE(pool.intern(1, 3) == half);
+        CHECK_EQ(pool.get(half).getNumerator(), 1);
+        CHECK_EQ(pool.get(half).getDenominator(), 2);
+
+        // Small fractions are precomputed, and nothing is stored for them
+        CHECK_EQ(pool.size(), 0);
+        CHECK_THROWS_AS(pool.intern(1, 0), std::invalid_argument);
+    }
+
+    TEST_CASE("Every small pair maps to its reduced fraction") {
+        FractionPool pool;
+        std::set<std::uint32_t> distinct;
+        bool consistent = true;
+        for (int den = -pooling::SMALL_LIMIT; den <= pooling::SMALL_LIMIT; ++den) {
+            for (int num = -pooling::SMALL_LIMIT; num <= pooling::SMALL_LIMIT; ++num) {
+                if (den == 0) {
+                    continue;
+                }
+                auto handle = pool.intern(num, den);
+                distinct.insert(handle.index);
+                consistent = consistent && Fraction::compare(pool.get(handle), Fraction(num, den)) == 0;
+                consistent = consistent && pool.intern(Fraction(num, den)) == handle;
+            }
+        }
+        CHECK(consistent);
+        CHECK_EQ(distinct.size(), pooling::SMALL_COUNT);
+        CHECK_EQ(pool.size(), 0);
+    }
+
+    TEST_CASE("Larger fractions are stored once") {
+        FractionPool pool;
+        auto first = pool.intern(1000, 3);
+        CHECK(pool.intern(-2000, -6) == first);
+        CHECK(pool.intern(Fraction(1000, 3)) == first);
+        CHECK(pool.intern(1, 65) == pool.intern(2, 130));
+        CHECK_EQ(pool.size(), 2);
+        CHECK_EQ(pool.get(first).getNumerator(), 1000);
+        CHECK_EQ(pool.get(first).getDenominator(), 3);
+
+        // Enough fractions to fill several chunks
+        std::vector<FractionPool::Handle> handles;
+        for (int i = 0; i < 10000; ++i) {
+            handles.push_back(pool.intern(i, 101));
+        }
+        bool consistent = true;
+        for (int i = 0; i < 10000; ++i) {
+            consistent = consistent && pool.intern(2 * i, 202) == handles[static_cast<std::size_t>(i)];
+            consistent = consistent && Fraction::compare(pool.get(handles[static_cast<std::size_t>(i)]), Fraction(i, 101)) == 0;
+        }
+        CHECK(consistent);
+    }
+
+    TEST_CASE("Threads agree on the handles") {
+        FractionPool pool;
+        const int count = 2000;
+        const unsigned int threads = 4;
+        std::vector<std::vector<FractionPool::Handle>> results(threads, std::vector<FractionPool::Handle>(count));
+        std::vector<std::thread> workers;
+        for (unsigned int t = 0; t < threads; ++t) {
+            workers.emplace_back([&pool, &results, t, count]() {
+                // Every thread walks the fractions in its own order
+                for (int k = 0; k < count; ++k) {
+                    int i = (k * 7 + static_cast<int>(t) * 500) % count;
+                    results[t][static_cast<std::size_t>(i)] = pool.intern(i + 100, 4099);
+                }
+            });
+        }
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+
+        bool agree = true;
+        for (unsigned int t = 1; t < threads; ++t) {
+            agree = agree && results[t] == results[0];
+        }
+        CHECK(agree);
+        CHECK_EQ(pool.size(), static_cast<std::size_t>(count));
+        CHECK_EQ(pool.get(results[0][5]).getNumerator(), 105);
+    }
+}
+
+TEST_SUITE("Checked arithmetic") {
+    bool same(const Fraction &lhs, const Fraction &rhs) {
+        return Fraction::compare(lhs, rhs) == 0;
+    }
+
+    TEST_CASE("Checked results match the operators") {
+        Fraction a(3, 4);
+        Fraction b(-5, 6);
+        Checked<Fraction> sum = Fraction::checked_add(a, b);
+        CHECK(sum.ok());
+        CHECK(static_cast<bool>(sum));
+        CHECK(sum.error == FractionError::None);
+        CHECK(same(sum.value, a + b));
+        CHECK(same(Fraction::checked_sub(a, b).value, a - b));
+        CHECK(same(Fraction::checked_mul(a, b).value, a * b));
+        CHECK(same(Fraction::checked_div(a, b).value, a / b));
+        CHECK(same(Fraction::checked_make(6, -8).value, Fraction(6, -8)));
+
+        // The checked functions are usable in constant expressions
+        static_assert(Fraction::checked_add(Fraction(1, 2), Fraction(1, 3)).value.getDenominator() == 6);
+        static_assert(noexcept(Fraction::checked_div(Fraction(), Fraction())));
+    }
+
+    TEST_CASE("Errors are reported instead of thrown") {
+        int max = std::numeric_limits<int>::max();
+        Fraction big(max, 1);
+        Fraction tiny(1, max);
+        Checked<Fraction> sum = Fraction::checked_add(big, big);
+        CHECK_FALSE(sum.ok());
+        CHECK(sum.error == FractionError::Overflow);
+        CHECK(same(sum.value, Fraction()));
+        CHECK(Fraction::checked_sub(Fraction(-max, 1), big).error == FractionError::Overflow);
+        CHECK(Fraction::checked_mul(big, Fraction(2, 1)).error == FractionError::Overflow);
+        CHECK(Fraction::checked_div(tiny, big).error == FractionError::Overflow);
+        CHECK(Fraction::checked_div(big, Fraction()).error == FractionError::DivideByZero);
+        CHECK(Fraction::checked_make(1, 0).error == FractionError::ZeroDenominator);
+
+        // Terms in range whose canonical form is not
+        int min = std::numeric_limits<int>::min();
+        CHECK(Fraction::checked_make(1, min).error == FractionError::Overflow);
+        CHECK(Fraction::checked_make(min, -1).error == FractionError::Overflow);
+        CHECK(same(Fraction::checked_make(min, 1).value, Fraction(min, 1)));
+        CHECK(same(Fraction::checked_make(2, min).value, Fraction(-1, 1 << 30)));
+        static_assert(noexcept(Fraction::checked_make(1, min)));
+
+        // The operators throw for the same errors
+        CHECK_THROWS_AS(big + big, std::overflow_error);
+        CHECK_THROWS_AS(big * Fraction(2, 1), std::overflow_error);
+        CHECK_THROWS_AS(big / Fraction(), std::runtime_error);
+    }
+
+    TEST_CASE("Cross products may overflow when the result fits") {
+        // 2^30 * 3 overflows int, but the sum and difference do not
+        Fraction a(1 << 30, 3);
+        Fraction b(-(1 << 30), 3);
+        CHECK(same(a + b, Fraction()));
+        CHECK(same(a - a, Fraction()));
+        CHECK(same(Fraction::checked_sub(a, Fraction((1 << 30) - 3, 3)).value, Fraction(1, 1)));
+        CHECK(Fraction::checked_add(a, Fraction(1 << 30, 1)).error == FractionError::Overflow);
+    }
+
+    TEST_CASE("A fraction can be combined with itself") {
+        Fraction a(2, 3);
+        CHECK(same(a - a, Fraction()));
+        a += a;
+        CHECK(same(a, Fraction(4, 3)));
+    }
+
+    TEST_CASE("Other widths") {
+        BasicFraction<std::int8_t> a(100, 1);
+        CHECK(BasicFraction<std::int8_t>::checked_add(a, a).error == FractionError::Overflow);
+        CHECK(BasicFraction<std::int8_t>::checked_sub(a, BasicFraction<std::int8_t>(27, 1)).value.getNumerator() == 73);
+
+        using Wide = BasicFraction<__int128>;
+        Wide big(std::numeric_limits<__int128>::max(), 3);
+        CHECK(Wide::checked_mul(big, Wide(6, 1)).error == FractionError::Overflow);
+        CHECK(Wide::checked_add(big, Wide(1, 3)).error == FractionError::Overflow);
+        CHECK(Wide::checked_div(Wide(1, 3), Wide(1, 6)).value.getNumerator() == 2);
+    }
+
+    TEST_CASE("Checked parsing") {
+        Checked<Fraction> parsed = checked_parse(" 6/-8 ");
+        CHECK(parsed.ok());
+        CHECK(same(parsed.value, Fraction(-3, 4)));
+        CHECK(checked_parse("1/0").error == FractionError::ZeroDenominator);
+        CHECK(checked_parse("99999999999/2").error == FractionError::Overflow);
+        CHECK(checked_parse("1/-2147483648").error == FractionError::Overflow);
+        CHECK(checked_parse("-2147483648 -1").error == FractionError::Overflow);
+        CHECK(checked_parse("-2147483648/2").value.getNumerator() == -(1 << 30));
+        CHECK(checked_parse("1/2 x").error == FractionError::InvalidInput);
+        CHECK(checked_parse("abc").error == FractionError::InvalidInput);
+    }
+}
+
+TEST_SUITE("Canonical form") {
+    bool has_terms(const Fraction &fraction, int num, int den) {
+        return fraction.getNumerator() == num && fraction.getDenominator() == den;
+    }
+
+    TEST_CASE("The sign is on the numerator") {
+        CHECK(has_terms(Fraction(3, -4), -3, 4));
+        CHECK(has_terms(Fraction(-6, -8), 3, 4));
+        CHECK(has_terms(Fraction(0, -5), 0, 1));
+        CHECK(has_terms(Fraction(1, 2) / Fraction(-1, 3), -3, 2));
+        CHECK(has_terms(Fraction(-1, 2) / Fraction(-1, 3), 3, 2));
+        CHECK(has_terms(Fraction(1, -2) * Fraction(1, 3), -1, 6));
+        CHECK(has_terms(Fraction(1, -2) - Fraction(1, -3), -1, 6));
+        CHECK_EQ(std::string(Fraction(3, -4)), "-3/4");
+        std::ostringstream out;
+        out << Fraction(3, -4);
+        CHECK_EQ(out.str(), "-3/4");
+    }
+
+    TEST_CASE("The minimum is kept only where its sign allows") {
+        int min = std::numeric_limits<int>::min();
+        CHECK(has_terms(Fraction(min, 1), min, 1));
+        CHECK(has_terms(Fraction(min, -2), 1 << 30, 1));
+        CHECK(has_terms(Fraction(min, min), 1, 1));
+        CHECK_THROWS_AS(Fraction(1, min), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(min, -1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 1) / Fraction(min, 1), std::overflow_error);
+        CHECK(Fraction::checked_div(Fraction(2, 1), Fraction(min, 1)).ok());
+    }
+
+    TEST_CASE("Accessors are plain loads") {
+        static_assert(noexcept(Fraction().getNumerator()));
+        static_assert(noexcept(Fraction().getDenominator()));
+        static_assert(noexcept(Fraction().to_float()));
+        static_assert(noexcept(Fraction().to_double()));
+        static_assert(noexcept(Fraction().to_int()));
+        static_assert(Fraction(7, -2).to_int() == -3);
+        CHECK_EQ(Fraction(-7, 2).to_double(), -3.5);
+    }
+
+    TEST_CASE("Wider terms are canonical too") {
+        BasicFraction<std::int64_t> wide(5, -10);
+        CHECK(wide.getNumerator() == -1);
+        CHECK(wide.getDenominator() == 2);
+        BasicFraction<__int128> widest(3, -9);
+        CHECK(widest.getNumerator() == -1);
+        CHECK(widest.getDenominator() == 3);
+        CHECK(BasicFraction<__int128>::compare(widest, BasicFraction<__int128>(-1, 2)) > 0);
+    }
+}
+
+TEST_SUITE("Layout") {
+    TEST_CASE("A fraction is two terms, copyable with memcpy") {
+        static_assert(is_plain_fraction<int>);
+        static_assert(sizeof(Fraction) == 2 * sizeof(int));
+        static_assert(std::is_trivially_copyable_v<BasicFraction<__int128>>);
+        static_assert(std::is_nothrow_move_constructible_v<Fraction>);
+
+        Fraction source(-7, 3);
+        Fraction copy;
+        std::memcpy(&copy, &source, sizeof(Fraction));
+        CHECK_EQ(copy.getNumerator(), -7);
+        CHECK_EQ(copy.getDenominator(), 3);
+
+        // Vector growth and insertion move fractions in bulk
+        std::vector<Fraction> fractions;
+        for (int i = 1; i <= 1000; i++) {
+            fractions.insert(fractions.begin(), Fraction(i, i + 1));
+        }
+        CHECK_EQ(fractions.front().getNumerator(), 1000);
+        CHECK_EQ(fractions.back().getDenominator(), 2);
+    }
+}
+
+TEST_SUITE("Sums by the GCD of the denominators") {
+    bool has_terms(const Fraction &fraction, int num, int den) {
+        return fraction.getNumerator() == num && fraction.getDenominator() == den;
+    }
+
+    TEST_CASE("Every path gives the reduced sum") {
+        CHECK(has_terms(Fraction(3, 1) + Fraction(-5, 1), -2, 1));
+        CHECK(has_terms(Fraction(1, 6) + Fraction(1, 6), 1, 3));
+        CHECK(has_terms(Fraction(1, 6) - Fraction(1, 6), 0, 1));
+        CHECK(has_terms(Fraction(1, 3) + Fraction(1, 6), 1, 2));
+        CHECK(has_terms(Fraction(5, 12) - Fraction(1, 4), 1, 6));
+        CHECK(has_terms(Fraction(1, 4) - Fraction(5, 12), -1, 6));
+        CHECK(has_terms(Fraction(1, 6) + Fraction(1, 10), 4, 15));
+        CHECK(has_terms(Fraction(7, 10) - Fraction(1, 15), 19, 30));
+        CHECK(has_terms(Fraction(2, 3) + Fraction(1, 5), 13, 15));
+        CHECK(has_terms(Fraction(3, 1) + Fraction(1, 2), 7, 2));
+        CHECK(has_terms(Fraction(1, 2) - Fraction(3, 1), -5, 2));
+
+        // Random operands against the sum over the product of the denominators, reduced afterwards
+        std::mt19937 gen(2024);
+        std::uniform_int_distribution<int> num_dist(-2000, 2000);
+        std::uniform_int_distribution<int> den_dist(1, 2000);
+        int mismatches = 0;
+        for (int i = 0; i < 20000; i++) {
+            int a = num_dist(gen), b = den_dist(gen), c = num_dist(gen), d = den_dist(gen);
+            Fraction lhs(a, b);
+            Fraction rhs(c, d);
+            long long bd = static_cast<long long>(lhs.getDenominator()) * rhs.getDenominator();
+            long long ad = static_cast<long long>(lhs.getNumerator()) * rhs.getDenominator();
+            long long cb = static_cast<long long>(rhs.getNumerator()) * lhs.getDenominator();
+            long long sum_gcd = std::gcd(ad + cb, bd);
+            long long diff_gcd = std::gcd(ad - cb, bd);
+            Fraction sum = lhs + rhs;
+            Fraction diff = lhs - rhs;
+            mismatches += sum.getNumerator() != (ad + cb) / sum_gcd || sum.getDenominator() != bd / sum_gcd;
+            mismatches += diff.getNumerator() != (ad - cb) / diff_gcd || diff.getDenominator() != bd / diff_gcd;
+        }
+        CHECK_EQ(mismatches, 0);
+    }
+
+    TEST_CASE("Sums overflow only when the result does not fit") {
+        int max = std::numeric_limits<int>::max();
+        CHECK(has_terms(Fraction(1 << 30, 3) + Fraction(1, 3), (1 << 30) + 1, 3));
+        CHECK(has_terms(Fraction(max, 6) - Fraction(max - 6, 6), 1, 1));
+        CHECK(has_terms(Fraction(1, 46341) + Fraction(1, 92682), 1, 30894));
+        CHECK_THROWS_AS(Fraction(max, 1) + Fraction(1, 1), std::overflow_error);
+        CHECK_THROWS_AS(Fraction(1, 46349) + Fraction(1, 46351), std::overflow_error);
+        CHECK(Fraction::checked_sub(Fraction(std::numeric_limits<int>::min(), 1), Fraction(1, 1)).error == FractionError::Overflow);
+
+        // The partial sums of 1/(k(k+1)) are k/(k+1), although the products of the denominators are about k^3
+        Fraction sum;
+        for (int k = 1; k <= 10000; k++) {
+            sum += Fraction(1, k) - Fraction(1, k + 1);
+        }
+        CHECK(has_terms(sum, 10000, 10001));
+    }
+
+    TEST_CASE("Vectors sum by the GCD too") {
+        int max = std::numeric_limits<int>::max();
+        const Fraction lhs[] = {Fraction(1 << 30, 3), Fraction(max, 6), Fraction(1, 46341), Fraction(1, 92682), Fraction(1, 100000)};
+        const Fraction rhs[] = {Fraction(1, 3), Fraction(max - 6, 6), Fraction(1, 92682), Fraction(1, 92682), Fraction(1, 100000)};
+        const simd::Isa isas[] = {simd::Isa::Scalar, simd::Isa::SSE4, simd::Isa::AVX2};
+        for (simd::Isa isa : isas) {
+            simd::set_isa(isa);
+
+            // Each pair in the vector part and in the tail, among elements whose cross products fit
+            for (size_t index : {size_t(3), size_t(16)}) {
+                for (size_t pair = 0; pair < std::size(lhs); pair++) {
+                    FractionVector left(17);
+                    FractionVector right(17);
+                    left.set(index, lhs[pair]);
+                    right.set(index, rhs[pair]);
+                    left.set(5, Fraction(1, 2));
+                    right.set(5, Fraction(1, 3));
+                    FractionVector sum = left + right;
+                    FractionVector difference = left - right;
+                    CHECK(has_terms(sum[index], (lhs[pair] + rhs[pair]).getNumerator(), (lhs[pair] + rhs[pair]).getDenominator()));
+                    CHECK(has_terms(difference[index], (lhs[pair] - rhs[pair]).getNumerator(), (lhs[pair] - rhs[pair]).getDenominator()));
+                    CHECK(has_terms(sum[5], 5, 6));
+                }
+
+                FractionVector left(17);
+                FractionVector right(17);
+                left.set(index, Fraction(1, 46349));
+                right.set(index, Fraction(1, 46351));
+                CHECK_THROWS_AS(left + right, std::overflow_error);
+                left.set(index, Fraction(max, 1));
+                right.set(index, Fraction(1, 1));
+                CHECK_THROWS_AS(left + right, std::overflow_error);
+            }
+        }
+        simd::set_isa(simd::best_isa());
+    }
+
+    TEST_CASE("Other widths") {
+        using Fraction8 = BasicFraction<std::int8_t>;
+        Fraction8 sum = Fraction8(1, 60) + Fraction8(1, 40);
+        CHECK(sum.getNumerator() == 1);
+        CHECK(sum.getDenominator() == 24);
+        CHECK_THROWS_AS(Fraction8(1, 11) + Fraction8(1, 13), std::overflow_error);
+
+        using Fraction128 = BasicFraction<__int128>;
+        __int128 big = static_cast<__int128>(1) << 100;
+        Fraction128 wide = Fraction128(1, big) + Fraction128(1, big * 3);
+        CHECK(wide.getNumerator() == 1);
+        CHECK(wide.getDenominator() == (big * 3) / 4);
+    }
+}
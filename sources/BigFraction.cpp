@@ -0,0 +1,219 @@
+/**
+ * @file BigFraction.cpp
+ * @brief Implementation file for the BigFraction class.
+ */
+
+#include "BigFraction.hpp"
+
+using namespace ariel;
+
+/**
+ * @brief Creates the fraction numerator / denominator.
+ *
+ * @param input_numerator The numerator of the fraction.
+ * @param input_denominator The denominator of the fraction.
+ *
+ * @throws std::invalid_argument if the denominator is zero.
+ */
+BigFraction::BigFraction(BigInt input_numerator, BigInt input_denominator)
+    : numerator(std::move(input_numerator)), denominator(std::move(input_denominator))
+{
+    if (denominator.is_zero())
+    {
+        throw std::invalid_argument("Denominator can't be zero");
+    }
+    reduce();
+}
+
+/**
+ * @brief Creates the fraction value / 1.
+ *
+ * @param value The value.
+ */
+BigFraction::BigFraction(long long int value)
+    : numerator(value)
+{
+}
+
+/**
+ * @brief Converts a Fraction exactly.
+ *
+ * @param fraction The fraction to convert.
+ */
+BigFraction::BigFraction(const Fraction &fraction)
+    : numerator(fraction.getNumerator()), denominator(fraction.getDenominator())
+{
+    // Fraction is already canonical: reduced, with a positive denominator
+}
+
+/**
+ * @brief Divides both terms by their GCD and moves the sign to the numerator.
+ */
+void BigFraction::reduce()
+{
+    if (denominator.is_negative())
+    {
+        numerator = -numerator;
+        denominator = -denominator;
+    }
+
+    BigInt common = BigInt::gcd(numerator, denominator);
+    if (common != 1)
+    {
+        numerator /= common;
+        denominator /= common;
+    }
+}
+
+/**
+ * @brief Adds two fractions.
+ *
+ * @param other The fraction to add.
+ * @return The exact sum in reduced form.
+ */
+BigFraction BigFraction::operator+(const BigFraction &other) const
+{
+    // With equal denominators the sum needs no new common denominator
+    if (denominator == other.denominator)
+    {
+        return BigFraction(numerator + other.numerator, denominator);
+    }
+    return BigFraction(numerator * other.denominator + other.numerator * denominator, denominator * other.denominator);
+}
+
+/**
+ * @brief Subtracts two fractions.
+ *
+ * @param other The fraction to subtract.
+ * @return The exact difference in reduced form.
+ */
+BigFraction BigFraction::operator-(const BigFraction &other) const
+{
+    return *this + (-other);
+}
+
+/**
+ * @brief Multiplies two fractions.
+ *
+ * @param other The fraction to multiply by.
+ * @return The exact product in reduced form.
+ */
+BigFraction BigFraction::operator*(const BigFraction &other) const
+{
+    return BigFraction(numerator * other.numerator, denominator * other.denominator);
+}
+
+/**
+ * @brief Divides two fractions.
+ *
+ * @param other The fraction to divide by.
+ * @return The exact quotient in reduced form.
+ * @throws std::runtime_error if other is zero.
+ */
+BigFraction BigFraction::operator/(const BigFraction &other) const
+{
+    if (other.numerator.is_zero())
+    {
+        Fraction::error_zero();
+    }
+    return BigFraction(numerator * other.denominator, denominator * other.numerator);
+}
+
+BigFraction BigFraction::operator-() const
+{
+    BigFraction result(*this);
+    result.numerator = -numerator;
+    return result;
+}
+
+BigFraction &BigFraction::operator+=(const BigFraction &other)
+{
+    *this = *this + other;
+    return *this;
+}
+
+BigFraction &BigFraction::operator-=(const BigFraction &other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+BigFraction &BigFraction::operator*=(const BigFraction &other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+BigFraction &BigFraction::operator/=(const BigFraction &other)
+{
+    *this = *this / other;
+    return *this;
+}
+
+/**
+ * @brief Three-way comparison by exact cross-multiplication.
+ *
+ * @param lhs The left-hand fraction.
+ * @param rhs The right-hand fraction.
+ * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+ */
+int BigFraction::compare(const BigFraction &lhs, const BigFraction &rhs)
+{
+    // The signs decide unless they are equal; denominators are positive so cross-multiplying keeps the order
+    if (lhs.numerator.sign() != rhs.numerator.sign())
+    {
+        return lhs.numerator.sign() < rhs.numerator.sign() ? -1 : 1;
+    }
+    return BigInt::compare(lhs.numerator * rhs.denominator, rhs.numerator * lhs.denominator);
+}
+
+/**
+ * @brief True if both terms fit in an int.
+ */
+bool BigFraction::fits_fraction() const noexcept
+{
+    if (!numerator.fits_int64() || !denominator.fits_int64())
+    {
+        return false;
+    }
+    long long int num = numerator.to_int64();
+    long long int denom = denominator.to_int64();
+    return num >= std::numeric_limits<int>::min() && num <= std::numeric_limits<int>::max() &&
+           denom <= std::numeric_limits<int>::max();
+}
+
+/**
+ * @brief Converts back to a Fraction.
+ *
+ * @return The same value as a Fraction.
+ * @throws std::overflow_error if a term does not fit in an int.
+ */
+Fraction BigFraction::to_fraction() const
+{
+    if (!fits_fraction())
+    {
+        Fraction::error_overflow();
+    }
+    return Fraction(static_cast<int>(numerator.to_int64()), static_cast<int>(denominator.to_int64()));
+}
+
+/**
+ * @brief Converts to a double.
+ *
+ * Terms beyond the double range are scaled down together first, so huge fractions with moderate values
+ * still convert.
+ */
+double BigFraction::to_double() const noexcept
+{
+    std::size_t num_bits = numerator.bit_length();
+    std::size_t denom_bits = denominator.bit_length();
+    if (num_bits < 1000 && denom_bits < 1000)
+    {
+        return numerator.to_double() / denominator.to_double();
+    }
+
+    // Keep the top 64 bits of the larger term and the matching bits of the other
+    std::size_t shift = std::max(num_bits, denom_bits) - 64;
+    double value = static_cast<double>(numerator.bits_at(shift)) / static_cast<double>(denominator.bits_at(shift));
+    return numerator.is_negative() ? -value : value;
+}
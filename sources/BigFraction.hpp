@@ -0,0 +1,113 @@
+/**
+ * @file BigFraction.hpp
+ * @brief Header file for the BigFraction class, an arbitrary-precision fraction.
+ *
+ * A BigFraction holds its numerator and denominator as BigInts, so its arithmetic is exact and never throws
+ * std::overflow_error. It is always kept reduced with a positive denominator. A Fraction converts to a
+ * BigFraction implicitly, and a BigFraction converts back with to_fraction() when its value fits.
+ */
+
+#ifndef BIG_FRACTION_HPP
+#define BIG_FRACTION_HPP
+
+#include "BigInt.hpp"
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    class BigFraction
+    {
+    private:
+        BigInt numerator = 0;   // The numerator of the fraction
+        BigInt denominator = 1; // The denominator of the fraction - always positive
+
+        /**
+         * @brief Divides both terms by their GCD and moves the sign to the numerator.
+         */
+        void reduce();
+
+    public:
+        /**
+         * @brief Creates the fraction zero.
+         */
+        BigFraction() = default;
+
+        /**
+         * @brief Creates the fraction numerator / denominator.
+         *
+         * @throws std::invalid_argument if the denominator is zero.
+         */
+        BigFraction(BigInt numerator, BigInt denominator);
+
+        /**
+         * @brief Creates the fraction value / 1.
+         */
+        BigFraction(long long int value);
+
+        /**
+         * @brief Converts a Fraction exactly.
+         */
+        BigFraction(const Fraction &fraction);
+
+        // Arithmetic operators - the results are exact and reduced
+        BigFraction operator+(const BigFraction &other) const;
+        BigFraction operator-(const BigFraction &other) const;
+        BigFraction operator*(const BigFraction &other) const;
+        BigFraction operator/(const BigFraction &other) const; // Throws std::runtime_error if other is zero
+        BigFraction operator-() const;
+        BigFraction &operator+=(const BigFraction &other);
+        BigFraction &operator-=(const BigFraction &other);
+        BigFraction &operator*=(const BigFraction &other);
+        BigFraction &operator/=(const BigFraction &other);
+
+        /**
+         * @brief Three-way comparison by exact cross-multiplication.
+         *
+         * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+         */
+        static int compare(const BigFraction &lhs, const BigFraction &rhs);
+
+        // Both sides are reduced with positive denominators, so equality compares the terms
+        friend bool operator==(const BigFraction &lhs, const BigFraction &rhs)
+        {
+            return lhs.numerator == rhs.numerator && lhs.denominator == rhs.denominator;
+        }
+        friend bool operator!=(const BigFraction &lhs, const BigFraction &rhs) { return !(lhs == rhs); }
+        friend bool operator<(const BigFraction &lhs, const BigFraction &rhs) { return compare(lhs, rhs) < 0; }
+        friend bool operator>(const BigFraction &lhs, const BigFraction &rhs) { return compare(lhs, rhs) > 0; }
+        friend bool operator<=(const BigFraction &lhs, const BigFraction &rhs) { return compare(lhs, rhs) <= 0; }
+        friend bool operator>=(const BigFraction &lhs, const BigFraction &rhs) { return compare(lhs, rhs) >= 0; }
+
+        // Getters
+        const BigInt &getNumerator() const noexcept { return numerator; }
+        const BigInt &getDenominator() const noexcept { return denominator; }
+
+        /**
+         * @brief True if both terms fit in an int, i.e. to_fraction() will succeed.
+         */
+        bool fits_fraction() const noexcept;
+
+        /**
+         * @brief Converts back to a Fraction.
+         *
+         * @throws std::overflow_error if a term does not fit in an int.
+         */
+        Fraction to_fraction() const;
+
+        /**
+         * @brief Converts to a double.
+         */
+        double to_double() const noexcept;
+
+        /**
+         * @brief Prints the fraction in the format "numerator/denominator".
+         */
+        friend std::ostream &operator<<(std::ostream &ostrm, const BigFraction &fraction)
+        {
+            ostrm << fraction.numerator << "/" << fraction.denominator;
+            return ostrm;
+        }
+    };
+}
+
+#endif
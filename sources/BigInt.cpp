@@ -0,0 +1,665 @@
+/**
+ * @file BigInt.cpp
+ * @brief Implementation file for the BigInt class.
+ *
+ * Magnitudes are little-endian arrays of 32-bit limbs, so every limb product and every two-limb quotient
+ * fits in a 64-bit integer. Division is Knuth's Algorithm D (TAOCP 4.3.1) and the GCD is Lehmer's
+ * algorithm (TAOCP 4.5.2, Algorithm L) on the leading 32 bits, finishing with the binary GCD engine once
+ * both operands fit in 64 bits.
+ */
+
+#include "BigInt.hpp"
+#include "Gcd.hpp"
+
+#include <algorithm> // For std::copy_n and std::swap
+#include <stdexcept> // For standard exceptions
+
+using namespace ariel;
+
+namespace
+{
+    constexpr std::uint64_t LIMB_BASE = std::uint64_t{1} << 32U;
+    constexpr std::uint64_t LIMB_MASK = LIMB_BASE - 1;
+
+    // Three-way comparison of two trimmed magnitudes
+    int compare_magnitudes(const LimbBuffer &lhs, const LimbBuffer &rhs) noexcept
+    {
+        if (lhs.size() != rhs.size())
+        {
+            return lhs.size() < rhs.size() ? -1 : 1;
+        }
+        for (std::size_t i = lhs.size(); i-- > 0;)
+        {
+            if (lhs[i] != rhs[i])
+            {
+                return lhs[i] < rhs[i] ? -1 : 1;
+            }
+        }
+        return 0;
+    }
+
+    // |lhs| + |rhs|
+    LimbBuffer add_magnitudes(const LimbBuffer &lhs, const LimbBuffer &rhs)
+    {
+        const LimbBuffer &longer = lhs.size() >= rhs.size() ? lhs : rhs;
+        const LimbBuffer &shorter = lhs.size() >= rhs.size() ? rhs : lhs;
+
+        LimbBuffer result;
+        result.resize(longer.size() + 1);
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < longer.size(); ++i)
+        {
+            std::uint64_t sum = carry + longer[i] + (i < shorter.size() ? shorter[i] : 0U);
+            result[i] = static_cast<std::uint32_t>(sum);
+            carry = sum >> 32U;
+        }
+        result[longer.size()] = static_cast<std::uint32_t>(carry);
+        result.trim();
+        return result;
+    }
+
+    // |lhs| - |rhs|, where |lhs| >= |rhs|
+    LimbBuffer subtract_magnitudes(const LimbBuffer &lhs, const LimbBuffer &rhs)
+    {
+        LimbBuffer result;
+        result.resize(lhs.size());
+        std::uint64_t borrow = 0;
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+        {
+            std::uint64_t subtrahend = borrow + (i < rhs.size() ? rhs[i] : 0U);
+            std::uint64_t difference = (LIMB_BASE + lhs[i]) - subtrahend;
+            result[i] = static_cast<std::uint32_t>(difference);
+            borrow = difference < LIMB_BASE ? 1U : 0U;
+        }
+        result.trim();
+        return result;
+    }
+
+    // |lhs| * |rhs|, schoolbook
+    LimbBuffer multiply_magnitudes(const LimbBuffer &lhs, const LimbBuffer &rhs)
+    {
+        LimbBuffer result;
+        if (lhs.empty() || rhs.empty())
+        {
+            return result;
+        }
+        result.resize(lhs.size() + rhs.size());
+        for (std::size_t i = 0; i < lhs.size(); ++i)
+        {
+            std::uint64_t carry = 0;
+            for (std::size_t j = 0; j < rhs.size(); ++j)
+            {
+                std::uint64_t product = static_cast<std::uint64_t>(lhs[i]) * rhs[j] + result[i + j] + carry;
+                result[i + j] = static_cast<std::uint32_t>(product);
+                carry = product >> 32U;
+            }
+            result[i + rhs.size()] = static_cast<std::uint32_t>(carry);
+        }
+        result.trim();
+        return result;
+    }
+
+    // Divides |lhs| by a single non-zero limb, returning the remainder
+    std::uint32_t divide_by_limb(const LimbBuffer &lhs, std::uint32_t divisor, LimbBuffer &quotient)
+    {
+        quotient.resize(lhs.size());
+        std::uint64_t remainder = 0;
+        for (std::size_t i = lhs.size(); i-- > 0;)
+        {
+            std::uint64_t current = (remainder << 32U) | lhs[i];
+            quotient[i] = static_cast<std::uint32_t>(current / divisor);
+            remainder = current % divisor;
+        }
+        quotient.trim();
+        return static_cast<std::uint32_t>(remainder);
+    }
+
+    // Divides |lhs| by |rhs| (at least two limbs, lhs at least as long) with Knuth's Algorithm D
+    void divide_magnitudes(const LimbBuffer &lhs, const LimbBuffer &rhs, LimbBuffer &quotient, LimbBuffer &remainder)
+    {
+        const std::size_t m = lhs.size();
+        const std::size_t n = rhs.size();
+
+        // Normalize so the divisor's top limb has its high bit set; the quotient digit estimates are then
+        // at most two too large
+        auto shift = static_cast<unsigned int>(__builtin_clz(rhs[n - 1]));
+        LimbBuffer divisor;
+        divisor.resize(n);
+        LimbBuffer dividend;
+        dividend.resize(m + 1);
+        for (std::size_t i = n; i-- > 0;)
+        {
+            std::uint64_t wide = (static_cast<std::uint64_t>(rhs[i]) << shift) | (i > 0 && shift > 0 ? rhs[i - 1] >> (32U - shift) : 0U);
+            divisor[i] = static_cast<std::uint32_t>(wide);
+        }
+        dividend[m] = shift > 0 ? lhs[m - 1] >> (32U - shift) : 0U;
+        for (std::size_t i = m; i-- > 0;)
+        {
+            std::uint64_t wide = (static_cast<std::uint64_t>(lhs[i]) << shift) | (i > 0 && shift > 0 ? lhs[i - 1] >> (32U - shift) : 0U);
+            dividend[i] = static_cast<std::uint32_t>(wide);
+        }
+
+        quotient.resize(m - n + 1);
+        for (std::size_t j = m - n + 1; j-- > 0;)
+        {
+            // Estimate the quotient digit from the top two limbs, then correct it with the next limb
+            std::uint64_t top = (static_cast<std::uint64_t>(dividend[j + n]) << 32U) | dividend[j + n - 1];
+            std::uint64_t qhat = top / divisor[n - 1];
+            std::uint64_t rhat = top % divisor[n - 1];
+            while (qhat >= LIMB_BASE || qhat * divisor[n - 2] > ((rhat << 32U) | dividend[j + n - 2]))
+            {
+                --qhat;
+                rhat += divisor[n - 1];
+                if (rhat >= LIMB_BASE)
+                {
+                    break;
+                }
+            }
+
+            // Multiply and subtract
+            std::int64_t borrow = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                std::uint64_t product = qhat * divisor[i];
+                std::int64_t difference = static_cast<std::int64_t>(dividend[i + j]) - borrow - static_cast<std::int64_t>(product & LIMB_MASK);
+                dividend[i + j] = static_cast<std::uint32_t>(difference);
+                borrow = static_cast<std::int64_t>(product >> 32U) - (difference >> 32);
+            }
+            std::int64_t last = static_cast<std::int64_t>(dividend[j + n]) - borrow;
+            dividend[j + n] = static_cast<std::uint32_t>(last);
+
+            // The estimate was one too large - add the divisor back
+            if (last < 0)
+            {
+                --qhat;
+                std::uint64_t carry = 0;
+                for (std::size_t i = 0; i < n; ++i)
+                {
+                    std::uint64_t sum = static_cast<std::uint64_t>(dividend[i + j]) + divisor[i] + carry;
+                    dividend[i + j] = static_cast<std::uint32_t>(sum);
+                    carry = sum >> 32U;
+                }
+                dividend[j + n] = static_cast<std::uint32_t>(dividend[j + n] + carry);
+            }
+            quotient[j] = static_cast<std::uint32_t>(qhat);
+        }
+        quotient.trim();
+
+        // Undo the normalization on the remainder
+        remainder.resize(n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            std::uint64_t wide = (static_cast<std::uint64_t>(dividend[i + 1]) << 32U) | dividend[i];
+            remainder[i] = static_cast<std::uint32_t>(wide >> shift);
+        }
+        remainder.trim();
+    }
+}
+
+// ********** LimbBuffer **********
+
+LimbBuffer::LimbBuffer(const LimbBuffer &other)
+{
+    resize(other.count);
+    std::copy_n(other.data(), other.count, data());
+}
+
+LimbBuffer::LimbBuffer(LimbBuffer &&other) noexcept
+    : heap(std::move(other.heap)), count(other.count), capacity(other.capacity)
+{
+    if (!heap)
+    {
+        std::copy_n(other.local, count, local);
+    }
+    other.count = 0;
+    other.capacity = INLINE_LIMBS;
+}
+
+LimbBuffer &LimbBuffer::operator=(const LimbBuffer &other)
+{
+    if (this != &other)
+    {
+        count = 0;
+        resize(other.count);
+        std::copy_n(other.data(), other.count, data());
+    }
+    return *this;
+}
+
+LimbBuffer &LimbBuffer::operator=(LimbBuffer &&other) noexcept
+{
+    if (this != &other)
+    {
+        heap = std::move(other.heap);
+        count = other.count;
+        capacity = other.capacity;
+        if (!heap)
+        {
+            std::copy_n(other.local, count, local);
+        }
+        other.count = 0;
+        other.capacity = INLINE_LIMBS;
+    }
+    return *this;
+}
+
+/**
+ * @brief Changes the number of limbs. New limbs are zero.
+ *
+ * @param size The new number of limbs.
+ */
+void LimbBuffer::resize(std::size_t size)
+{
+    if (size > capacity)
+    {
+        // Grow geometrically so repeated push_back is amortized constant time
+        std::size_t grown = std::max(size, capacity * 2);
+        std::unique_ptr<std::uint32_t[]> bigger(new std::uint32_t[grown]());
+        std::copy_n(data(), count, bigger.get());
+        heap = std::move(bigger);
+        capacity = grown;
+    }
+    std::uint32_t *limbs = data();
+    for (std::size_t i = count; i < size; ++i)
+    {
+        limbs[i] = 0;
+    }
+    count = size;
+}
+
+/**
+ * @brief Appends a limb.
+ *
+ * @param limb The limb to append.
+ */
+void LimbBuffer::push_back(std::uint32_t limb)
+{
+    resize(count + 1);
+    data()[count - 1] = limb;
+}
+
+/**
+ * @brief Drops leading zero limbs.
+ */
+void LimbBuffer::trim() noexcept
+{
+    const std::uint32_t *limbs = data();
+    while (count > 0 && limbs[count - 1] == 0)
+    {
+        --count;
+    }
+}
+
+// ********** BigInt **********
+
+/**
+ * @brief Creates a BigInt holding value.
+ *
+ * @param value The value.
+ */
+BigInt::BigInt(long long int value)
+    : negative(value < 0)
+{
+    auto magnitude = value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+    while (magnitude != 0)
+    {
+        limbs.push_back(static_cast<std::uint32_t>(magnitude));
+        magnitude >>= 32U;
+    }
+}
+
+namespace ariel
+{
+    /**
+     * @brief Adds two BigInts.
+     */
+    BigInt operator+(const BigInt &lhs, const BigInt &rhs)
+    {
+        BigInt result;
+        if (lhs.negative == rhs.negative)
+        {
+            result.limbs = add_magnitudes(lhs.limbs, rhs.limbs);
+            result.negative = lhs.negative;
+        }
+        else if (compare_magnitudes(lhs.limbs, rhs.limbs) >= 0)
+        {
+            result.limbs = subtract_magnitudes(lhs.limbs, rhs.limbs);
+            result.negative = lhs.negative;
+        }
+        else
+        {
+            result.limbs = subtract_magnitudes(rhs.limbs, lhs.limbs);
+            result.negative = rhs.negative;
+        }
+        result.negative = result.negative && !result.is_zero();
+        return result;
+    }
+
+    /**
+     * @brief Subtracts two BigInts.
+     */
+    BigInt operator-(const BigInt &lhs, const BigInt &rhs)
+    {
+        return lhs + (-rhs);
+    }
+
+    /**
+     * @brief Multiplies two BigInts.
+     */
+    BigInt operator*(const BigInt &lhs, const BigInt &rhs)
+    {
+        BigInt result;
+        result.limbs = multiply_magnitudes(lhs.limbs, rhs.limbs);
+        result.negative = lhs.negative != rhs.negative && !result.is_zero();
+        return result;
+    }
+
+    /**
+     * @brief Divides two BigInts, truncating toward zero.
+     *
+     * @throws std::runtime_error if rhs is zero.
+     */
+    BigInt operator/(const BigInt &lhs, const BigInt &rhs)
+    {
+        BigInt quotient;
+        BigInt remainder;
+        BigInt::divide(lhs, rhs, quotient, remainder);
+        return quotient;
+    }
+
+    /**
+     * @brief The remainder of dividing two BigInts, with the sign of lhs.
+     *
+     * @throws std::runtime_error if rhs is zero.
+     */
+    BigInt operator%(const BigInt &lhs, const BigInt &rhs)
+    {
+        BigInt quotient;
+        BigInt remainder;
+        BigInt::divide(lhs, rhs, quotient, remainder);
+        return remainder;
+    }
+}
+
+BigInt BigInt::operator-() const
+{
+    BigInt result(*this);
+    result.negative = !negative && !is_zero();
+    return result;
+}
+
+BigInt &BigInt::operator+=(const BigInt &other)
+{
+    *this = *this + other;
+    return *this;
+}
+
+BigInt &BigInt::operator-=(const BigInt &other)
+{
+    *this = *this - other;
+    return *this;
+}
+
+BigInt &BigInt::operator*=(const BigInt &other)
+{
+    *this = *this * other;
+    return *this;
+}
+
+BigInt &BigInt::operator/=(const BigInt &other)
+{
+    *this = *this / other;
+    return *this;
+}
+
+/**
+ * @brief Divides lhs by rhs, truncating toward zero.
+ *
+ * @param lhs The dividend.
+ * @param rhs The divisor.
+ * @param quotient Receives lhs / rhs.
+ * @param remainder Receives lhs % rhs, with the sign of lhs.
+ * @throws std::runtime_error if rhs is zero.
+ */
+void BigInt::divide(const BigInt &lhs, const BigInt &rhs, BigInt &quotient, BigInt &remainder)
+{
+    if (rhs.is_zero())
+    {
+        throw std::runtime_error("Can't divide by zero");
+    }
+
+    LimbBuffer quotient_limbs;
+    LimbBuffer remainder_limbs;
+    if (compare_magnitudes(lhs.limbs, rhs.limbs) < 0)
+    {
+        remainder_limbs = lhs.limbs;
+    }
+    else if (rhs.limbs.size() == 1)
+    {
+        std::uint32_t rest = divide_by_limb(lhs.limbs, rhs.limbs[0], quotient_limbs);
+        if (rest != 0)
+        {
+            remainder_limbs.push_back(rest);
+        }
+    }
+    else
+    {
+        divide_magnitudes(lhs.limbs, rhs.limbs, quotient_limbs, remainder_limbs);
+    }
+
+    bool lhs_negative = lhs.negative;
+    bool quotient_negative = lhs.negative != rhs.negative;
+    quotient.limbs = std::move(quotient_limbs);
+    quotient.negative = quotient_negative && !quotient.is_zero();
+    remainder.limbs = std::move(remainder_limbs);
+    remainder.negative = lhs_negative && !remainder.is_zero();
+}
+
+/**
+ * @brief Three-way comparison.
+ *
+ * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+ */
+int BigInt::compare(const BigInt &lhs, const BigInt &rhs) noexcept
+{
+    if (lhs.negative != rhs.negative)
+    {
+        return lhs.negative ? -1 : 1;
+    }
+    int diff = compare_magnitudes(lhs.limbs, rhs.limbs);
+    return lhs.negative ? -diff : diff;
+}
+
+/**
+ * @brief The greatest common divisor of |lhs| and |rhs|, computed with Lehmer's algorithm.
+ *
+ * While the smaller operand is longer than 64 bits, the leading 32 bits of both operands are run through
+ * Euclid's algorithm in single precision, collecting the cofactors of the steps whose quotients the
+ * leading bits determine exactly. One multi-precision linear combination then applies all of those steps
+ * at once. Only when no step can be taken is a full multi-precision division done.
+ *
+ * @return gcd(|lhs|, |rhs|), with gcd(0, 0) = 0.
+ */
+BigInt BigInt::gcd(BigInt lhs, BigInt rhs)
+{
+    lhs.negative = false;
+    rhs.negative = false;
+    if (lhs < rhs)
+    {
+        std::swap(lhs, rhs);
+    }
+
+    while (rhs.limbs.size() > 2)
+    {
+        // The leading 32 bits of lhs, and the bits of rhs at the same position
+        std::size_t shift = lhs.bit_length() - 32;
+        auto lead = static_cast<std::int64_t>(lhs.bits_at(shift));
+        auto next = static_cast<std::int64_t>(rhs.bits_at(shift));
+
+        // Simulate Euclid on the leading bits while both quotient bounds agree (Knuth's Algorithm L)
+        std::int64_t a = 1, b = 0, c = 0, d = 1;
+        while (next + c != 0 && next + d != 0)
+        {
+            std::int64_t quotient = (lead + a) / (next + c);
+            if (quotient != (lead + b) / (next + d))
+            {
+                break;
+            }
+            std::int64_t tmp = a - quotient * c;
+            a = c;
+            c = tmp;
+            tmp = b - quotient * d;
+            b = d;
+            d = tmp;
+            tmp = lead - quotient * next;
+            lead = next;
+            next = tmp;
+        }
+
+        if (b == 0)
+        {
+            // The leading bits did not determine a single quotient - take a full division step
+            BigInt remainder = lhs % rhs;
+            lhs = std::move(rhs);
+            rhs = std::move(remainder);
+        }
+        else
+        {
+            BigInt first = BigInt(a) * lhs + BigInt(b) * rhs;
+            BigInt second = BigInt(c) * lhs + BigInt(d) * rhs;
+            lhs = std::move(first);
+            rhs = std::move(second);
+        }
+    }
+
+    if (rhs.is_zero())
+    {
+        return lhs;
+    }
+
+    // Once rhs fits in 64 bits, one division brings lhs down too and the binary engine finishes the job
+    BigInt remainder = lhs % rhs;
+    auto common = gcd::compute(rhs.bits_at(0), remainder.bits_at(0));
+    BigInt result;
+    while (common != 0)
+    {
+        result.limbs.push_back(static_cast<std::uint32_t>(common));
+        common >>= 32U;
+    }
+    return result;
+}
+
+BigInt BigInt::abs() const
+{
+    BigInt result(*this);
+    result.negative = false;
+    return result;
+}
+
+/**
+ * @brief The number of significant bits of the magnitude.
+ */
+std::size_t BigInt::bit_length() const noexcept
+{
+    if (limbs.empty())
+    {
+        return 0;
+    }
+    auto top_bits = static_cast<std::size_t>(32 - __builtin_clz(limbs[limbs.size() - 1]));
+    return (limbs.size() - 1) * 32 + top_bits;
+}
+
+/**
+ * @brief Returns (|this| >> shift) truncated to 64 bits.
+ *
+ * @param shift The number of low bits to drop.
+ */
+std::uint64_t BigInt::bits_at(std::size_t shift) const noexcept
+{
+    std::size_t index = shift / 32;
+    auto offset = static_cast<unsigned int>(shift % 32);
+
+    // Gather the three limbs that can contribute to the result
+    unsigned __int128 window = 0;
+    for (std::size_t i = 3; i-- > 0;)
+    {
+        window <<= 32U;
+        if (index + i < limbs.size())
+        {
+            window |= limbs[index + i];
+        }
+    }
+    return static_cast<std::uint64_t>(window >> offset);
+}
+
+/**
+ * @brief True if the value fits in a long long.
+ */
+bool BigInt::fits_int64() const noexcept
+{
+    if (limbs.size() > 2)
+    {
+        return false;
+    }
+    std::uint64_t magnitude = bits_at(0);
+    return negative ? magnitude <= (std::uint64_t{1} << 63U) : magnitude < (std::uint64_t{1} << 63U);
+}
+
+/**
+ * @brief Converts to a long long.
+ *
+ * @throws std::overflow_error if the value does not fit.
+ */
+long long int BigInt::to_int64() const
+{
+    if (!fits_int64())
+    {
+        throw std::overflow_error("Overflow");
+    }
+    std::uint64_t magnitude = bits_at(0);
+    return static_cast<long long int>(negative ? 0ULL - magnitude : magnitude);
+}
+
+/**
+ * @brief Converts to a double.
+ */
+double BigInt::to_double() const noexcept
+{
+    double result = 0;
+    for (std::size_t i = limbs.size(); i-- > 0;)
+    {
+        result = result * static_cast<double>(LIMB_BASE) + limbs[i];
+    }
+    return negative ? -result : result;
+}
+
+/**
+ * @brief Formats the value in decimal.
+ */
+std::string BigInt::to_string() const
+{
+    if (is_zero())
+    {
+        return "0";
+    }
+
+    // Peel off nine decimal digits at a time, least significant group first
+    std::string digits;
+    LimbBuffer rest = limbs;
+    while (!rest.empty())
+    {
+        LimbBuffer quotient;
+        std::uint32_t group = divide_by_limb(rest, 1000000000U, quotient);
+        rest = std::move(quotient);
+        for (int i = 0; i < 9 && (group != 0 || !rest.empty()); ++i)
+        {
+            digits += static_cast<char>('0' + group % 10);
+            group /= 10;
+        }
+    }
+    if (negative)
+    {
+        digits += '-';
+    }
+    return std::string(digits.rbegin(), digits.rend());
+}
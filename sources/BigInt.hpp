@@ -0,0 +1,184 @@
+/**
+ * @file BigInt.hpp
+ * @brief Header file for the BigInt class, the arbitrary-precision integer behind BigFraction.
+ *
+ * A BigInt is a sign and a magnitude stored as little-endian 32-bit limbs. Magnitudes of up to
+ * LimbBuffer::INLINE_LIMBS limbs (128 bits) live inside the object, so the values that come up when
+ * fractions of ints are added or multiplied never touch the heap. GCDs of large values use Lehmer's
+ * algorithm, which replaces most multi-precision divisions with single-precision steps on the leading bits.
+ */
+
+#ifndef BIG_INT_HPP
+#define BIG_INT_HPP
+
+#include <cstddef>  // For std::size_t
+#include <cstdint>  // For the limb types
+#include <iostream> // For output streams
+#include <memory>   // For std::unique_ptr
+#include <string>   // For string operations
+
+namespace ariel
+{
+    /**
+     * @brief A growable array of 32-bit limbs with inline storage for small values.
+     */
+    class LimbBuffer
+    {
+    public:
+        static constexpr std::size_t INLINE_LIMBS = 4;
+
+        LimbBuffer() noexcept = default;
+        LimbBuffer(const LimbBuffer &other);
+        LimbBuffer(LimbBuffer &&other) noexcept;
+        LimbBuffer &operator=(const LimbBuffer &other);
+        LimbBuffer &operator=(LimbBuffer &&other) noexcept;
+        ~LimbBuffer() = default;
+
+        std::size_t size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+        std::uint32_t *data() noexcept { return heap ? heap.get() : local; }
+        const std::uint32_t *data() const noexcept { return heap ? heap.get() : local; }
+        std::uint32_t &operator[](std::size_t index) noexcept { return data()[index]; }
+        std::uint32_t operator[](std::size_t index) const noexcept { return data()[index]; }
+
+        /**
+         * @brief True if the limbs are stored inside the object rather than on the heap.
+         */
+        bool is_inline() const noexcept { return !heap; }
+
+        /**
+         * @brief Changes the number of limbs. New limbs are zero.
+         */
+        void resize(std::size_t size);
+
+        /**
+         * @brief Appends a limb.
+         */
+        void push_back(std::uint32_t limb);
+
+        /**
+         * @brief Drops leading zero limbs, so that zero has no limbs at all.
+         */
+        void trim() noexcept;
+
+    private:
+        std::uint32_t local[INLINE_LIMBS] = {};
+        std::unique_ptr<std::uint32_t[]> heap;
+        std::size_t count = 0;
+        std::size_t capacity = INLINE_LIMBS;
+    };
+
+    /**
+     * @brief An arbitrary-precision signed integer.
+     */
+    class BigInt
+    {
+    private:
+        LimbBuffer limbs;      // The magnitude, least significant limb first, without leading zeros
+        bool negative = false; // The sign - always false for zero
+
+    public:
+        /**
+         * @brief Creates zero.
+         */
+        BigInt() noexcept = default;
+
+        /**
+         * @brief Creates a BigInt holding value. Never allocates.
+         */
+        BigInt(long long int value);
+
+        // Arithmetic operators
+        friend BigInt operator+(const BigInt &lhs, const BigInt &rhs);
+        friend BigInt operator-(const BigInt &lhs, const BigInt &rhs);
+        friend BigInt operator*(const BigInt &lhs, const BigInt &rhs);
+        friend BigInt operator/(const BigInt &lhs, const BigInt &rhs); // Truncates toward zero
+        friend BigInt operator%(const BigInt &lhs, const BigInt &rhs); // Has the sign of lhs
+        BigInt operator-() const;
+        BigInt &operator+=(const BigInt &other);
+        BigInt &operator-=(const BigInt &other);
+        BigInt &operator*=(const BigInt &other);
+        BigInt &operator/=(const BigInt &other);
+
+        /**
+         * @brief Divides lhs by rhs, truncating toward zero.
+         *
+         * @param quotient Receives lhs / rhs.
+         * @param remainder Receives lhs % rhs, with the sign of lhs.
+         * @throws std::runtime_error if rhs is zero.
+         */
+        static void divide(const BigInt &lhs, const BigInt &rhs, BigInt &quotient, BigInt &remainder);
+
+        /**
+         * @brief Three-way comparison.
+         *
+         * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+         */
+        static int compare(const BigInt &lhs, const BigInt &rhs) noexcept;
+
+        friend bool operator==(const BigInt &lhs, const BigInt &rhs) noexcept { return compare(lhs, rhs) == 0; }
+        friend bool operator!=(const BigInt &lhs, const BigInt &rhs) noexcept { return compare(lhs, rhs) != 0; }
+        friend bool operator<(const BigInt &lhs, const BigInt &rhs) noexcept { return compare(lhs, rhs) < 0; }
+        friend bool operator>(const BigInt &lhs, const BigInt &rhs) noexcept { return compare(lhs, rhs) > 0; }
+        friend bool operator<=(const BigInt &lhs, const BigInt &rhs) noexcept { return compare(lhs, rhs) <= 0; }
+        friend bool operator>=(const BigInt &lhs, const BigInt &rhs) noexcept { return compare(lhs, rhs) >= 0; }
+
+        /**
+         * @brief The greatest common divisor of |lhs| and |rhs|, computed with Lehmer's algorithm.
+         *
+         * @return gcd(|lhs|, |rhs|), with gcd(0, 0) = 0.
+         */
+        static BigInt gcd(BigInt lhs, BigInt rhs);
+
+        // Observers
+        bool is_zero() const noexcept { return limbs.empty(); }
+        bool is_negative() const noexcept { return negative; }
+        int sign() const noexcept { return negative ? -1 : (is_zero() ? 0 : 1); }
+        BigInt abs() const;
+
+        /**
+         * @brief The number of significant bits of the magnitude.
+         */
+        std::size_t bit_length() const noexcept;
+
+        /**
+         * @brief Returns (|this| >> shift) truncated to 64 bits.
+         */
+        std::uint64_t bits_at(std::size_t shift) const noexcept;
+
+        /**
+         * @brief True if the magnitude is stored inline, without a heap allocation.
+         */
+        bool is_inline() const noexcept { return limbs.is_inline(); }
+
+        /**
+         * @brief True if the value fits in a long long.
+         */
+        bool fits_int64() const noexcept;
+
+        /**
+         * @brief Converts to a long long.
+         *
+         * @throws std::overflow_error if the value does not fit.
+         */
+        long long int to_int64() const;
+
+        /**
+         * @brief Converts to the nearest double (truncating the bits beyond double precision).
+         */
+        double to_double() const noexcept;
+
+        /**
+         * @brief Formats the value in decimal.
+         */
+        std::string to_string() const;
+
+        friend std::ostream &operator<<(std::ostream &ostrm, const BigInt &value)
+        {
+            ostrm << value.to_string();
+            return ostrm;
+        }
+    };
+}
+
+#endif
@@ -1,6 +1,6 @@
 /**
  * @file Fraction.cpp
- * @brief Implementation file for the Fraction class.
+ * @brief Implementation file for the BasicFraction class template.
  *
  * This file was written by Maya Rom, ID: 207485251. It contains the implementation of the Fraction class,
  * which represents a fraction with numerator and denominator. It provides various arithmetic and comparison
@@ -12,80 +12,161 @@
 
 #include "Fraction.hpp"
 
-using namespace ariel;
+#include <cmath> // For std::frexp and std::ldexp
 
-// MAXINT and MININT are used for overflow error handling
-const int MAXINT = std::numeric_limits<int>::max();
-const int MININT = std::numeric_limits<int>::min();
+using namespace ariel;
 
-// log function for debugging - prints the message to the console
-void Fraction::log(const std::string &message)
-{
-    std::cout << "[Fraction]: " << message << std::endl;
+namespace
+{
+    using Magnitude = unsigned __int128;
+
+    // A finite double as (-1)^negative * mantissa * 2^exponent, with an odd mantissa unless it is zero
+    struct BinaryValue
+    {
+        bool negative;
+        std::uint64_t mantissa;
+        int exponent;
+    };
+
+    /**
+     * @brief The GCD of value and divisor, a divisor of a decimal scale.
+     *
+     * The only prime factors of the divisor are two and five, so the GCD is found from the trailing zeros
+     * and by trial division by five, without a general GCD.
+     */
+    template <typename UWide>
+    UWide scale_gcd(UWide value, UWide divisor)
+    {
+        if (value == 0)
+        {
+            return divisor;
+        }
+
+        // The divisor is below 2^64, so its twos are in the low word
+        auto low = static_cast<unsigned long long>(value);
+        int divisor_twos = __builtin_ctzll(static_cast<unsigned long long>(divisor));
+        int twos = low == 0 ? divisor_twos : std::min(__builtin_ctzll(low), divisor_twos);
+        UWide common = static_cast<UWide>(1) << static_cast<unsigned int>(twos);
+
+        // What is left of the divisor is a power of five
+        divisor >>= static_cast<unsigned int>(divisor_twos);
+        while (divisor % 5 == 0 && value % 5 == 0)
+        {
+            value /= 5;
+            divisor /= 5;
+            common *= 5;
+        }
+        return common;
+    }
+
+    BinaryValue decompose(double value)
+    {
+        int exponent = 0;
+        double significand = std::frexp(std::fabs(value), &exponent);
+        auto mantissa = static_cast<std::uint64_t>(std::ldexp(significand, 53));
+        exponent -= 53;
+        if (mantissa != 0)
+        {
+            int zeros = __builtin_ctzll(mantissa);
+            mantissa >>= zeros;
+            exponent += zeros;
+        }
+        return {std::signbit(value), mantissa, exponent};
+    }
+
+    /**
+     * @brief The best rational approximation num/den of p/q with num <= num_limit and den <= den_limit.
+     *
+     * Walks the continued fraction of p/q exactly. When the next convergent exceeds a limit, the answer is
+     * either the last convergent or the largest semiconvergent within the limits, whichever is closer.
+     */
+    void best_approximation(Magnitude p, Magnitude q, Magnitude num_limit, Magnitude den_limit, long double value,
+                            Magnitude &num, Magnitude &den)
+    {
+        // Convergents h/k, starting from 0/1 and 1/0
+        Magnitude h0 = 0, h1 = 1, k0 = 1, k1 = 0;
+        for (;;)
+        {
+            Magnitude a = p / q;
+            Magnitude h2 = 0;
+            Magnitude k2 = 0;
+            bool over = __builtin_mul_overflow(a, h1, &h2) | __builtin_add_overflow(h2, h0, &h2) |
+                        __builtin_mul_overflow(a, k1, &k2) | __builtin_add_overflow(k2, k0, &k2);
+            if (over || h2 > num_limit || k2 > den_limit)
+            {
+                // The caller ensures the integer part fits, so this is never the first step and k1 > 0;
+                // h1 is zero after the first step for values below one
+                Magnitude t = (den_limit - k0) / k1;
+                if (h1 != 0)
+                {
+                    t = std::min(t, (num_limit - h0) / h1);
+                }
+                Magnitude semi_num = t * h1 + h0;
+                Magnitude semi_den = t * k1 + k0;
+
+                // The semiconvergent is closer if t is more than half of a, and the convergent if less;
+                // a tie needs the actual errors
+                bool semi = 2 * t > a;
+                if (t != 0 && 2 * t == a)
+                {
+                    long double convergent_error = std::fabs(value - static_cast<long double>(h1) / static_cast<long double>(k1));
+                    long double semi_error = std::fabs(value - static_cast<long double>(semi_num) / static_cast<long double>(semi_den));
+                    semi = semi_error < convergent_error;
+                }
+                num = semi ? semi_num : h1;
+                den = semi ? semi_den : k1;
+                return;
+            }
+
+            Magnitude remainder = p - a * q;
+            if (remainder == 0)
+            {
+                num = h2;
+                den = k2;
+                return;
+            }
+            h0 = h1;
+            h1 = h2;
+            k0 = k1;
+            k1 = k2;
+            p = q;
+            q = remainder;
+        }
+    }
 }
 
 // Constructors and destructors
 
-/**
- * @brief Constructs a new Fraction object with the given numerator and denominator.
- *
- * @param input_numerator The numerator of the fraction.
- * @param input_denominator The denominator of the fraction.
- *
- * @throws std::invalid_argument if the denominator is zero.
- */
-Fraction::Fraction(int input_numerator, int input_denominator)
-{
-    if (input_denominator == 0)
-    {
-        // Throw an exception if the denominator is zero
-        throw std::invalid_argument("Denominator can't be zero");
-    }
-
-    // Error handling for overflow
-    if (input_numerator > MAXINT || input_numerator < MININT || input_denominator > MAXINT || input_denominator < MININT)
-    {
-        // Throw an exception if overflow occurs
-        throw std::overflow_error("Overflow");
-    }
-
-    // Log a message indicating the creation of a fraction from integer numerator and denominator
-    log("Creating fraction from int numerator and denominator");
-
-    // Reduce the fraction to its simplest form
-    reduce(input_numerator, input_denominator);
-
-    // Assign the numerator and denominator to the object's member variables
-    numerator = input_numerator;
-    denominator = input_denominator;
-}
-
 /**
  * @brief Constructs a new Fraction object from a double value.
  *
  * @param value The value to convert to a fraction.
  */
-Fraction::Fraction(double value)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision>::BasicFraction(double value)
 {
-    // Error handling for overflow
-    int MAXINT = std::numeric_limits<int>::max();
-    int MININT = std::numeric_limits<int>::min();
-
-    if (value > static_cast<float>(MAXINT) || value < static_cast<float>(MININT))
+    // Error handling for overflow: the value must be in range, and its scaled value must fit in the wide
+    // type before it is truncated to it (NaN fails both comparisons of the second test)
+    double scaled = value * static_cast<double>(Precision::scale);
+    if (value > static_cast<float>(Traits::max_value) || value < static_cast<float>(Traits::min_value) ||
+        !(std::fabs(scaled) < static_cast<double>(FractionTraits<Wide>::max_value)))
     {
         // Throw an exception if overflow occurs
-        throw std::overflow_error("Overflow");
+        error_overflow();
     }
 
     // Log a message indicating the creation of a fraction from a double value
     log("Creating fraction from double value");
 
-    // Convert the double value to a fraction by multiplying it by a suitable factor
-    numerator = value * FACTOR;
-    denominator = FACTOR;
+    // Convert the double value to a fraction by scaling it to the precision and truncating. The scale may
+    // not fit in narrow terms, so the fraction is reduced in the wide type before it is stored.
+    auto num = static_cast<Wide>(scaled);
+    auto denom = static_cast<Wide>(Precision::scale);
 
     // Reduce the fraction to its simplest form
-    reduce(numerator, denominator);
+    reduce(num, denom);
+    numerator = narrow(num);
+    denominator = narrow(denom);
 }
 
 /**
@@ -93,164 +174,334 @@ Fraction::Fraction(double value)
  *
  * @param value The value to convert to a fraction.
  */
-Fraction::Fraction(float value)
-    : is_negative(false) // Initialize is_negative to false
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision>::BasicFraction(float value)
 {
-    // Error handling for overflow
-    int MAXINT = std::numeric_limits<int>::max();
-    int MININT = std::numeric_limits<int>::min();
-
-    if (value > static_cast<float>(MAXINT) || value < static_cast<float>(MININT))
+    // Error handling for overflow: the value must be in range, and its scaled value must fit in the wide
+    // type before it is truncated to it (NaN fails both comparisons of the second test)
+    float scaled = value * static_cast<float>(Precision::scale);
+    if (value > static_cast<float>(Traits::max_value) || value < static_cast<float>(Traits::min_value) ||
+        !(std::fabs(scaled) < static_cast<float>(FractionTraits<Wide>::max_value)))
     {
         // Throw an exception if overflow occurs
-        throw std::overflow_error("Overflow");
+        error_overflow();
     }
 
     // Log a message indicating the creation of a fraction from a float value
     log("Creating fraction from float value");
 
-    // Convert the float value to a fraction by multiplying it by a suitable factor
-    numerator = value * FACTOR;
-    denominator = FACTOR;
+    // Convert the float value to a fraction by scaling it to the precision and truncating. The scale may
+    // not fit in narrow terms, so the fraction is reduced in the wide type before it is stored.
+    auto num = static_cast<Wide>(scaled);
+    auto denom = static_cast<Wide>(Precision::scale);
 
     // Reduce the fraction to its simplest form
-    reduce(numerator, denominator);
+    reduce(num, denom);
+    numerator = narrow(num);
+    denominator = narrow(denom);
 }
 
 /**
- * @brief Copy constructor for Fraction objects.
+ * @brief Converts a floating-point value with the chosen conversion.
  *
- * @param other The Fraction object to copy.
+ * @param value The value to convert.
+ * @param conversion Truncate to the fraction's precision, Exact, or the best Approximation.
+ * @param max_denominator The largest denominator Approximate may return.
+ * @return The converted fraction, reduced.
  */
-Fraction::Fraction(const Fraction &other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::from_double(double value, FloatConversion conversion, IntT max_denominator)
 {
-    // Check if the object is being copied to itself
-    if (this == &other)
+    if (!std::isfinite(value))
     {
-        return; // No need to perform the copy
+        error_invalid();
+    }
+    if (conversion == FloatConversion::Truncate)
+    {
+        return BasicFraction(value);
+    }
+    if (max_denominator <= 0)
+    {
+        throw std::invalid_argument("Maximum denominator must be positive");
     }
 
-    // Error handling for overflow
-    int MAXINT = std::numeric_limits<int>::max();
-    int MININT = std::numeric_limits<int>::min();
+    // Values of 2^digits and above, or below -2^digits, cannot be a numerator, whatever the conversion
+    constexpr int digits = static_cast<int>(sizeof(IntT) * 8 - 1);
+    if (value >= std::ldexp(1.0, digits) || value < -std::ldexp(1.0, digits))
+    {
+        error_overflow();
+    }
 
-    if (other.getNumerator() > MAXINT || other.getNumerator() < MININT || other.getDenominator() > MAXINT || other.getDenominator() < MININT)
+    BinaryValue binary = decompose(value);
+    auto limit = static_cast<Magnitude>(Traits::max_value);
+    Magnitude num = 0;
+    Magnitude den = 1;
+    if (binary.mantissa == 0 || binary.exponent >= 0)
     {
-        // Throw an exception if overflow occurs
-        throw std::overflow_error("Overflow");
+        // An integer, which fits after the range check above
+        num = static_cast<Magnitude>(binary.mantissa) << binary.exponent;
+    }
+    else if (conversion == FloatConversion::Exact)
+    {
+        // mantissa / 2^-exponent is already reduced, since the mantissa is odd
+        if (-binary.exponent >= digits)
+        {
+            error_overflow();
+        }
+        num = binary.mantissa;
+        den = static_cast<Magnitude>(1) << -binary.exponent;
+    }
+    else if (-binary.exponent < 127)
+    {
+        best_approximation(binary.mantissa, static_cast<Magnitude>(1) << -binary.exponent, limit,
+                           static_cast<Magnitude>(max_denominator), std::fabs(static_cast<long double>(value)), num, den);
+    }
+    else
+    {
+        // Below 2^-73 the value is too small for an exact 128-bit denominator: the candidates are 0 and 1/max
+        if (std::fabs(value) * 2 * static_cast<double>(max_denominator) > 1)
+        {
+            num = 1;
+            den = static_cast<Magnitude>(max_denominator);
+        }
     }
 
-    // Log a message indicating the creation of a fraction from the copy constructor
-    log("Creating fraction from copy constructor");
+    // A negative numerator may reach the minimum, one past the limit; negate in the unsigned type so it wraps
+    if (num > limit + static_cast<Magnitude>(binary.negative) || den > limit)
+    {
+        error_overflow();
+    }
+    BasicFraction result;
+    result.numerator = binary.negative ? static_cast<IntT>(Magnitude{0} - num) : static_cast<IntT>(num);
+    result.denominator = num == 0 ? 1 : static_cast<IntT>(den);
+    return result;
+}
 
-    // Copy the numerator and denominator from the other Fraction object
-    numerator = other.getNumerator();
-    denominator = other.getDenominator();
+/**
+ * @brief Computes this fraction * Precision::scale rounded half away from zero.
+ *
+ * @return The scaled and rounded value.
+ * @throws std::overflow_error if 128-bit terms are too large to scale.
+ */
+template <typename IntT, typename Precision>
+typename BasicFraction<IntT, Precision>::Wide BasicFraction<IntT, Precision>::scaled_value() const
+{
+    // Narrower terms always fit scaled in the wide type; 128-bit terms have no wider type to scale in
+    if constexpr (!Traits::widens)
+    {
+        constexpr IntT limit = Traits::max_value / 2 / static_cast<IntT>(Precision::scale);
+        if (numerator > limit || numerator < -limit)
+        {
+            error_overflow();
+        }
+    }
+    return scaled_round(numerator, denominator);
 }
 
 /**
- * @brief Default constructor for Fraction objects.
+ * @brief Computes value * Precision::scale rounded half away from zero.
+ *
+ * The value is scaled in float, as the float constructor does, and the rounding is done on the truncated
+ * integer, so no call to round is needed.
  *
- * Sets the numerator to 0 and the denominator to 1.
+ * @param value The value to scale.
+ * @return The scaled and rounded value.
+ * @throws std::runtime_error if value is NaN.
+ * @throws std::overflow_error if value is out of the range of IntT.
  */
-Fraction::Fraction()
+template <typename IntT, typename Precision>
+typename BasicFraction<IntT, Precision>::Wide BasicFraction<IntT, Precision>::scale_float(float value)
 {
-    // error handling for overflow
-    if (0 > MAXINT || 0 < MININT || 1 > MAXINT || 1 < MININT)
+    if (std::isnan(value))
     {
-        throw std::overflow_error("Overflow");
+        error_invalid();
     }
-    // error handling for zero division
-    if (1 == 0)
+
+    // The range of the float constructor, and a scaled value the wide type can hold
+    float scaled = value * static_cast<float>(Precision::scale);
+    if (value > static_cast<float>(Traits::max_value) || value < static_cast<float>(Traits::min_value) ||
+        !(std::fabs(scaled) < static_cast<float>(FractionTraits<Wide>::max_value)))
     {
-        throw std::invalid_argument("Denominator can't be zero");
+        error_overflow();
     }
-    log("Creating fraction from default constructor");
-    numerator = 0;
-    denominator = 1;
-};
+
+    // Truncate, then move a remainder of at least a half away from zero
+    auto truncated = static_cast<Wide>(scaled);
+    float remainder = scaled - static_cast<float>(truncated);
+    return truncated + static_cast<Wide>(remainder >= 0.5F) - static_cast<Wide>(remainder <= -0.5F);
+}
 
 /**
- * @brief Move constructor for Fraction objects.
+ * @brief Converts the float operand of a mixed operation: the value rounded to the precision, as an exact
+ * fraction.
  *
- * @param other The Fraction object to move.
+ * @param value The float operand.
+ * @return The fraction.
+ * @throws std::runtime_error if value is NaN.
+ * @throws std::overflow_error if value is out of range, or its reduced terms do not fit in IntT.
  */
-Fraction::Fraction(Fraction &&other) noexcept
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::float_operand(float value)
 {
-    // Log a message indicating the creation of a fraction from the move constructor
-    log("Creating fraction from move constructor");
-
-    // Move the numerator and denominator from the other Fraction object
-    numerator = other.getNumerator();
-    denominator = other.getDenominator();
+    return from_scaled(scale_float(value));
 }
 
-// Operators for equality (=)
-Fraction &Fraction::operator=(Fraction &&other) noexcept
+/**
+ * @brief Returns the fraction scaled / Precision::scale, reduced.
+ *
+ * @param scaled The value scaled by Precision::scale.
+ * @return The fraction.
+ * @throws std::overflow_error if the reduced terms do not fit in IntT.
+ */
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::from_scaled(Wide scaled)
 {
-    // Check if the object is being move-assigned to itself
-    if (this == &other)
+    using UWide = typename FractionTraits<Wide>::unsigned_type;
+
+    BasicFraction result;
+    if (scaled == 0)
     {
-        log("Move assignment operator called on itself");
-        return *this;
+        return result;
     }
 
-    // Move the numerator and denominator from the other Fraction object
-    numerator = other.getNumerator();
-    denominator = other.getDenominator();
-
-    // Log a message indicating the move assignment operator has been called
-    log("Move assignment operator called");
+    // The scale is 2^decimals * 5^decimals, so the only common factors are at most decimals twos and fives.
+    // They are cancelled in the wide type, since the scale may not fit in narrow terms, without a GCD.
+    UWide num = magnitude(scaled);
+    auto denom = static_cast<UWide>(Precision::scale);
+    auto low = static_cast<unsigned long long>(num);
+    int twos = low == 0 ? Precision::decimals : std::min(__builtin_ctzll(low), Precision::decimals);
+    num >>= static_cast<unsigned int>(twos);
+    denom >>= static_cast<unsigned int>(twos);
+    for (int i = 0; i < Precision::decimals && num % 5 == 0; ++i)
+    {
+        num /= 5;
+        denom /= 5;
+    }
 
-    return *this;
+    result.numerator = narrow(scaled < 0 ? -static_cast<Wide>(num) : static_cast<Wide>(num));
+    result.denominator = narrow(static_cast<Wide>(denom));
+    return result;
 }
 
-Fraction &Fraction::operator=(const Fraction &other)
+/**
+ * @brief Returns scaled / Precision::scale plus this fraction, or minus it if negate, exactly.
+ *
+ * The float operand s/t is scaled / scale reduced, and the sum is formed as checked_sum forms it, by the
+ * GCD of the denominators. t divides the scale, so every GCD involved has no prime factors but two and
+ * five, and scale_gcd finds it without a general GCD: the exact sum costs no more than adding the values
+ * rounded to the precision. Terms too large for the wide type go through the fraction operators instead.
+ *
+ * @param scaled The float operand scaled by Precision::scale.
+ * @param negate Whether to subtract this fraction instead of adding it.
+ * @return The sum in reduced form.
+ * @throws std::overflow_error if the reduced terms do not fit in IntT.
+ */
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::plus_scaled(Wide scaled, bool negate) const
 {
-    // Check if the object is being copy-assigned to itself
-    if (this == &other)
+    using UWide = typename FractionTraits<Wide>::unsigned_type;
+
+    // The operand s/t in reduced form
+    auto scale = static_cast<UWide>(Precision::scale);
+    UWide common = scale_gcd(magnitude(scaled), scale);
+    Wide s = scaled / static_cast<Wide>(common);
+    auto t = static_cast<Wide>(scale / common);
+
+    // a/b + s/t = (a * (t/g) + s * (b/g)) / h over (b/g) * (t/h), with g = gcd(b, t) and h = gcd(sum, g)
+    auto b = static_cast<Wide>(denominator);
+    auto g = static_cast<Wide>(scale_gcd(static_cast<UWide>(b), static_cast<UWide>(t)));
+    Wide left = 0;
+    Wide right = 0;
+    Wide sum = 0;
+    Wide denom = 0;
+    if (!__builtin_mul_overflow(static_cast<Wide>(numerator), negate ? -(t / g) : t / g, &left) &&
+        !__builtin_mul_overflow(s, b / g, &right) &&
+        !__builtin_add_overflow(left, right, &sum))
     {
-        log("Copy assignment operator called on itself");
-        return *this;
+        auto h = static_cast<Wide>(scale_gcd(magnitude(sum), static_cast<UWide>(g)));
+        if (!__builtin_mul_overflow(b / g, t / h, &denom))
+        {
+            BasicFraction result;
+            result.numerator = narrow(sum / h);
+            result.denominator = narrow(denom);
+            result.check_invariant();
+            return result;
+        }
     }
 
-    // Error handling for overflow
-    int MAXINT = std::numeric_limits<int>::max();
-    int MININT = std::numeric_limits<int>::min();
+    BasicFraction operand = from_scaled(scaled);
+    return negate ? operand - *this : operand + *this;
+}
+
+/**
+ * @brief Returns this fraction divided by scaled / Precision::scale, exactly.
+ *
+ * With the divisor s/t as scaled / scale reduced, a/b / (s/t) is (a * t) / (b * s) with the common factors
+ * cancelled across the operands. gcd(b, t) divides the scale, so scale_gcd finds it; gcd(a, s) is a GCD
+ * of terms that fit in IntT. Terms too large for the wide type go through the fraction operators instead.
+ *
+ * @param scaled The divisor scaled by Precision::scale - must not be zero.
+ * @return The quotient in reduced form.
+ * @throws std::overflow_error if the reduced terms do not fit in IntT.
+ */
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::over_scaled(Wide scaled) const
+{
+    using UWide = typename FractionTraits<Wide>::unsigned_type;
 
-    if (other.getNumerator() > MAXINT || other.getNumerator() < MININT || other.getDenominator() > MAXINT || other.getDenominator() < MININT)
+    if (numerator == 0)
     {
-        // Throw an exception if overflow occurs
-        throw std::overflow_error("Overflow");
+        return BasicFraction();
     }
 
-    // Log a message indicating the copy assignment operator has been called
-    log("Copy assignment operator called");
+    // The divisor s/t in reduced form
+    auto scale = static_cast<UWide>(Precision::scale);
+    UWide common = scale_gcd(magnitude(scaled), scale);
+    Wide s = scaled / static_cast<Wide>(common);
+    auto t = static_cast<Wide>(scale / common);
 
-    // Copy the numerator and denominator from the other Fraction object
-    numerator = other.getNumerator();
-    denominator = other.getDenominator();
+    // Cancel gcd(a, s), reducing s modulo a first so the GCD runs in IntT, and gcd(b, t)
+    UInt a = magnitude(numerator);
+    auto cross1 = static_cast<Wide>(gcd::compute(a, static_cast<UInt>(magnitude(s) % a)));
+    auto cross2 = static_cast<Wide>(scale_gcd(static_cast<UWide>(denominator), static_cast<UWide>(t)));
+    Wide num = 0;
+    Wide denom = 0;
+    if (!__builtin_mul_overflow(static_cast<Wide>(numerator) / cross1, t / cross2, &num) &&
+        !__builtin_mul_overflow(static_cast<Wide>(denominator) / cross2, s / cross1, &denom) &&
+        (denom > 0 || (num != FractionTraits<Wide>::min_value && denom != FractionTraits<Wide>::min_value)))
+    {
+        // Move the sign of a negative divisor to the numerator
+        if (denom < 0)
+        {
+            num = -num;
+            denom = -denom;
+        }
+        BasicFraction result;
+        result.numerator = narrow(num);
+        result.denominator = narrow(denom);
+        result.check_invariant();
+        return result;
+    }
 
-    return *this;
+    return *this / from_scaled(scaled);
 }
 
-Fraction &Fraction::operator=(float other)
+// Operators for equality (=)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> &BasicFraction<IntT, Precision>::operator=(float other)
 {
     // Create a temporary Fraction object from the float value
-    Fraction tmp = Fraction(other);
+    BasicFraction tmp = BasicFraction(other);
 
     // Assign the numerator and denominator from the temporary Fraction object
     numerator = tmp.getNumerator();
     denominator = tmp.getDenominator();
 
     // Error handling for overflow
-    int MAXINT = std::numeric_limits<int>::max();
-    int MININT = std::numeric_limits<int>::min();
-
-    if (numerator > MAXINT || numerator < MININT || denominator > MAXINT || denominator < MININT)
+    if (numerator > Traits::max_value || numerator < Traits::min_value || denominator > Traits::max_value || denominator < Traits::min_value)
     {
         // Log an overflow error and throw an exception
-        log("Overflow error");
+        logging::log<logging::Level::Error>("Overflow error");
         throw std::overflow_error("Overflow");
     }
 
@@ -258,61 +509,27 @@ Fraction &Fraction::operator=(float other)
 }
 
 // Operators for addition (+)
-Fraction Fraction::operator+(const Fraction &other) const
-{
-    // Perform the addition using long long integers to avoid overflow
-    long long int num = static_cast<long long int>(numerator) * static_cast<long long int>(other.denominator) +
-                        static_cast<long long int>(other.numerator) * static_cast<long long int>(denominator);
-
-    long long int denom = static_cast<long long int>(denominator) * static_cast<long long int>(other.denominator);
-
-    // Error handling for overflow
-    int MAXINT = std::numeric_limits<int>::max();
-    int MININT = std::numeric_limits<int>::min();
-
-    if (num > MAXINT || num < MININT || denom > MAXINT || denom < MININT)
-    {
-        // Call an error handling function for overflow
-        error_overflow();
-    }
-
-    // Create and return a new Fraction object representing the sum
-    return Fraction(num, denom);
-}
-
-Fraction Fraction::operator+(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator+(float other)
 {
-    // Convert the Fraction object to a float value
-    float tmp = to_float();
-
-    // Round the float values to the desired precision
-    tmp = round(tmp * FACTOR) / FACTOR;
-    float tmp2 = round(other * FACTOR) / FACTOR;
-    float tmp3 = round((tmp + tmp2) * FACTOR) / FACTOR;
-
     // Log a message indicating the addition operator has been called
     log("Addition operator called");
 
-    // Create and return a new Fraction object representing the sum
-    return Fraction(tmp3);
+    // Scale the float once, then add exactly
+    return plus_scaled(scale_float(other), false);
 }
 
-Fraction Fraction::operator+=(const Fraction &other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator+=(const BasicFraction &other)
 {
-    // Check if the object is being added to itself
-    if (this == &other)
-    {
-        log("Addition assignment operator called on itself");
-        return *this;
-    }
-
-    // Use the addition operator to perform the addition
+    // Use the addition operator to perform the addition; it returns a new fraction, so other may be *this
     *this = *this + other;
 
     return *this;
 }
 
-Fraction Fraction::operator+=(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator+=(float other)
 {
     // Log a message indicating the addition assignment operator has been called
     log("Addition assignment operator called");
@@ -323,60 +540,42 @@ Fraction Fraction::operator+=(float other)
     return *this;
 }
 
-Fraction &Fraction::operator++()
+/**
+ * @brief Operator overload for the pre-increment of this fraction (add one).
+ *
+ * @return A reference to the modified Fraction object after the pre-increment.
+ * @throws std::overflow_error if the result does not fit in IntT; the fraction is left unchanged.
+ */
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> &BasicFraction<IntT, Precision>::operator++()
 {
-    // Increment the Fraction object by adding the denominator to the numerator
-    numerator += denominator;
-
-    // Reduce the fraction to its simplest form
-    reduce(numerator, denominator);
+    // Add one with the checked sum, which reports overflow instead of wrapping the numerator
+    BasicFraction one;
+    one.numerator = 1;
+    *this = unwrap(checked_add(*this, one));
 
     // Return a reference to the modified Fraction object
     return *this;
 }
 
-const Fraction Fraction::operator++(int)
-{
-    // Create a copy of the Fraction object
-    Fraction cpy(*this);
-
-    // Increment the Fraction object by adding the denominator to the numerator
-    numerator += denominator;
-
-    // Reduce the fraction to its simplest form
-    reduce(numerator, denominator);
-
-    // Return the original copy of the Fraction object
-    return cpy;
-}
-
 /**
- * @brief Operator overload for subtraction of another fraction from this fraction.
+ * @brief Operator overload for the post-increment of this fraction (add one).
  *
- * @param other The other fraction to subtract from this fraction.
- * @return A new Fraction object that is the result of the subtraction.
+ * @param An int, typically 0, used as a placeholder to differentiate between pre and post-increment.
+ * @return A copy of the Fraction object before the post-increment.
+ * @throws std::overflow_error if the result does not fit in IntT; the fraction is left unchanged.
  */
-Fraction Fraction::operator-(const Fraction &other) const
+template <typename IntT, typename Precision>
+const BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator++(int)
 {
-    // Check if subtracting the fraction from itself
-    if (this == &other)
-    {
-        return *this;
-    }
-
-    // Perform subtraction of the fractions using long long int to handle potential overflow
-    long long int num = static_cast<long long int>(numerator) * static_cast<long long int>(other.denominator) -
-                        static_cast<long long int>(other.numerator) * static_cast<long long int>(denominator);
-
-    long long int denom = static_cast<long long int>(denominator) * static_cast<long long int>(other.denominator);
+    // Create a copy of the Fraction object
+    BasicFraction cpy(*this);
 
-    // Check for overflow after subtraction
-    if (num > MAXINT || num < MININT || denom > MAXINT || denom < MININT)
-    {
-        throw std::overflow_error("Overflow error");
-    }
+    // Increment the Fraction object
+    ++*this;
 
-    return Fraction(num, denom);
+    // Return the original copy of the Fraction object
+    return cpy;
 }
 
 /**
@@ -385,14 +584,11 @@ Fraction Fraction::operator-(const Fraction &other) const
  * @param other The float to subtract from this fraction.
  * @return A new Fraction object that is the result of the subtraction.
  */
-Fraction Fraction::operator-(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator-(float other)
 {
-    // Convert this fraction to a float and perform subtraction
-    float tmp = to_float();
-    tmp = round(tmp * FACTOR) / FACTOR;
-    float tmp2 = round(other * FACTOR) / FACTOR;
-    float tmp3 = round((tmp - tmp2) * FACTOR) / FACTOR;
-    return Fraction(tmp3);
+    // Scale the float once, then add its negation exactly
+    return plus_scaled(-scale_float(other), false);
 }
 
 /**
@@ -401,7 +597,8 @@ Fraction Fraction::operator-(float other)
  * @param other The other fraction to subtract from this fraction.
  * @return A reference to the modified Fraction object after the subtraction.
  */
-Fraction Fraction::operator-=(const Fraction &other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator-=(const BasicFraction &other)
 {
     *this = *this - other;
     return *this;
@@ -414,7 +611,8 @@ Fraction Fraction::operator-=(const Fraction &other)
  * @param other The float to subtract from this fraction.
  * @return A reference to the modified Fraction object after the subtraction.
  */
-Fraction Fraction::operator-=(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator-=(float other)
 {
     log("Subtraction assignment operator called");
     *this = *this - other;
@@ -422,59 +620,48 @@ Fraction Fraction::operator-=(float other)
 };
 
 /**
- * @brief Operator overload for the pre-decrement of this fraction (subtract the denominator from the numerator).
+ * @brief Operator overload for the pre-decrement of this fraction (subtract one).
  *
  * @return A reference to the modified Fraction object after the pre-decrement.
+ * @throws std::overflow_error if the result does not fit in IntT; the fraction is left unchanged.
  */
-Fraction &Fraction::operator--()
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> &BasicFraction<IntT, Precision>::operator--()
 {
     log("Pre-decrement operator called");
-    numerator -= denominator;
-    reduce(numerator, denominator);
+    BasicFraction one;
+    one.numerator = 1;
+    *this = unwrap(checked_sub(*this, one));
     return *this;
 };
 
 /**
- * @brief Operator overload for the post-decrement of this fraction (subtract the denominator from the numerator).
+ * @brief Operator overload for the post-decrement of this fraction (subtract one).
  *
  * @param An int, typically 0, used as a placeholder to differentiate between pre and post-decrement.
  * @return A copy of the Fraction object before the post-decrement.
+ * @throws std::overflow_error if the result does not fit in IntT; the fraction is left unchanged.
  */
-const Fraction Fraction::operator--(int)
+template <typename IntT, typename Precision>
+const BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator--(int)
 {
-    Fraction cpy(*this);
-    numerator -= denominator;
-    reduce(numerator, denominator);
+    BasicFraction cpy(*this);
+    --*this;
     return cpy;
 };
 
 // ********** Operators for multiplication (*) **********
-Fraction Fraction::operator*(const Fraction &other) const
-{
-    long long int num = static_cast<long long int>(numerator) * static_cast<long long int>(other.numerator);
-    long long int denom = static_cast<long long int>(denominator) * static_cast<long long int>(other.denominator);
-
-    if (num > MAXINT || num < MININT)
-    {
-        error_overflow();
-    }
-    if (denom > MAXINT || denom < MININT)
-    {
-        error_overflow();
-    }
-
-    return Fraction(num, denom);
-}
-
 /**
  * @brief Operator overload for multiplication of a fraction and a float.
  *
  * @param other The float to multiply the fraction by.
  * @return A new Fraction object that is the result of the multiplication.
  */
-Fraction Fraction::operator*(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator*(float other)
 {
-    return *this * Fraction(other);
+    // Convert the float once, then multiply exactly
+    return *this * float_operand(other);
 };
 
 /**
@@ -483,7 +670,8 @@ Fraction Fraction::operator*(float other)
  * @param other The other fraction to multiply this fraction by.
  * @return A reference to the modified Fraction object after the multiplication.
  */
-Fraction Fraction::operator*=(const Fraction &other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator*=(const BasicFraction &other)
 {
     *this = *this * other;
     return *this;
@@ -495,7 +683,8 @@ Fraction Fraction::operator*=(const Fraction &other)
  * @param other The float to multiply the fraction by.
  * @return A reference to the modified Fraction object after the multiplication.
  */
-Fraction Fraction::operator*=(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator*=(float other)
 {
     *this = *this * other;
     return *this;
@@ -503,41 +692,14 @@ Fraction Fraction::operator*=(float other)
 
 // ********** Operators for division (/) **********
 
-/**
- * @brief Operator overload for division of two fractions.
- *
- * @param other The other fraction to divide by.
- * @return The result of dividing the fractions.
- */
-Fraction Fraction::operator/(const Fraction &other) const
-{
-    // Error handling for zero numerator in the other fraction
-    if (other.getNumerator() == 0)
-    {
-        error_zero();
-    }
-
-    // Perform the division using long long integers to avoid overflow
-    long long int num = static_cast<long long int>(numerator) * static_cast<long long int>(other.getDenominator());
-    long long int denom = static_cast<long long int>(denominator) * static_cast<long long int>(other.getNumerator());
-
-    // Error handling for overflow
-    if (num > MAXINT || num < MININT || denom > MAXINT || denom < MININT)
-    {
-        error_overflow();
-    }
-
-    // Create and return a new Fraction object representing the division result
-    return Fraction(num, denom);
-}
-
 /**
  * @brief Operator overload for division of a fraction by a float.
  *
  * @param other The float to divide by.
  * @return The result of dividing the fraction by the float.
  */
-Fraction Fraction::operator/(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator/(float other)
 {
     // Error handling for zero denominator
     if (other == 0)
@@ -545,15 +707,15 @@ Fraction Fraction::operator/(float other)
         error_zero();
     }
 
-    // Convert the fraction to a float value
-    float tmp = to_float();
-
-    // Perform the division with rounded precision
-    float tmp2 = round(other * FACTOR) / FACTOR;
-    float tmp3 = round((tmp / tmp2) * FACTOR) / FACTOR;
+    // Scale the float once; a divisor that rounds to zero cannot divide
+    Wide divisor = scale_float(other);
+    if (divisor == 0)
+    {
+        error_zero();
+    }
 
-    // Create and return a new Fraction object representing the division result
-    return Fraction(tmp3);
+    // Divide exactly
+    return over_scaled(divisor);
 }
 
 /**
@@ -562,7 +724,8 @@ Fraction Fraction::operator/(float other)
  * @param other The other fraction to divide by.
  * @return Reference to the modified fraction after division.
  */
-Fraction Fraction::operator/=(const Fraction &other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator/=(const BasicFraction &other)
 {
     // Error handling for zero numerator in the other fraction
     if (other.getNumerator() == 0)
@@ -582,7 +745,8 @@ Fraction Fraction::operator/=(const Fraction &other)
  * @param other The float to divide by.
  * @return Reference to the modified fraction after division.
  */
-Fraction Fraction::operator/=(float other)
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator/=(float other)
 {
     // Error handling for zero denominator
     if (other == 0)
@@ -598,56 +762,21 @@ Fraction Fraction::operator/=(float other)
 
 // ********** Operators for equality-checking (==, !=) **********
 
-/**
- * @brief Operator overload for equality comparison of two fractions.
- *
- * @param other The other fraction to compare to.
- * @return true if the two fractions are equal, false otherwise.
- */
-bool Fraction::operator==(const Fraction &other) const
-{
-    // Convert both fractions to float values
-    float val = to_float();
-    float otherVal = other.to_float();
-
-    // Compare the float values with rounded precision and return the result
-    return round(val * FACTOR) / FACTOR == round(otherVal * FACTOR) / FACTOR;
-}
-
 /**
  * @brief Operator overload for equality comparison of a fraction and a float.
  *
  * @param other The float to compare to.
  * @return true if the fraction is equal to the float, false otherwise.
  */
-bool Fraction::operator==(float other)
+template <typename IntT, typename Precision>
+bool BasicFraction<IntT, Precision>::operator==(float other) const
 {
-    // Convert the fraction to a float value
-    float val = to_float();
-
-    // Compare the float value with the given value with rounded precision and return the result
-    return round(val * FACTOR) / FACTOR == round(other * FACTOR) / FACTOR;
-}
-
-/**
- * @brief Operator overload for inequality comparison of two fractions.
- *
- * @param other The other fraction to compare to.
- * @return true if the two fractions are not equal, false otherwise.
- */
-bool Fraction::operator!=(const Fraction &other) const
-{
-    // Error handling for zero numerator in the other fraction
-    if (other.getNumerator() == 0)
-    {
-        error_zero();
-    }
-
-    // Check if the fraction is not equal to the other fraction
-    return !(*this == other);
+    // Compare the values rounded to the precision, as scaled integers
+    return scaled_value() == scale_float(other);
 }
 
-bool Fraction::operator!=(float other)
+template <typename IntT, typename Precision>
+bool BasicFraction<IntT, Precision>::operator!=(float other) const
 {
     // Error handling for zero denominator
     if (other == 0)
@@ -659,35 +788,14 @@ bool Fraction::operator!=(float other)
     return !(*this == other);
 }
 
-/**
- * @brief Operator overload for comparison of two fractions.
- *
- * @param other The other fraction to compare to.
- * @return true if this fraction is greater than the other fraction, false otherwise.
- */
-bool Fraction::operator>(const Fraction &other) const
-{
-    // Error handling for zero numerator in the other fraction
-    if (other.getNumerator() == 0)
-    {
-        error_zero();
-    }
-
-    // Convert both fractions to float values
-    float val = to_float();
-    float otherVal = other.to_float();
-
-    // Compare the float values and return the result
-    return (val > otherVal);
-}
-
 /**
  * @brief Operator overload for comparison of a fraction and a float.
  *
  * @param other The float to compare to.
  * @return true if this fraction is greater than the float, false otherwise.
  */
-bool Fraction::operator>(float other)
+template <typename IntT, typename Precision>
+bool BasicFraction<IntT, Precision>::operator>(float other) const
 {
     // Error handling for zero denominator
     if (other == 0)
@@ -702,29 +810,14 @@ bool Fraction::operator>(float other)
     return (val > other);
 }
 
-/**
- * @brief Operator overload for comparison of two fractions.
- *
- * @param other The other fraction to compare to.
- * @return true if this fraction is less than the other fraction, false otherwise.
- */
-bool Fraction::operator<(const Fraction &other) const
-{
-    // Convert both fractions to float values
-    float val = to_float();
-    float otherVal = other.to_float();
-
-    // Compare the float values and return the result
-    return (val < otherVal);
-}
-
 /**
  * @brief Operator overload for comparison of a fraction and a float.
  *
  * @param other The float to compare to.
  * @return true if this fraction is less than the float, false otherwise.
  */
-bool Fraction::operator<(float other)
+template <typename IntT, typename Precision>
+bool BasicFraction<IntT, Precision>::operator<(float other) const
 {
     // Convert the fraction to a float value
     float val = to_float();
@@ -733,36 +826,15 @@ bool Fraction::operator<(float other)
     return (val < other);
 }
 
-/**
- * @brief Operator overload for comparison of two fractions.
- *
- * @param other The other fraction to compare to.
- * @return true if this fraction is greater than or equal to the other fraction, false otherwise.
- */
-bool Fraction::operator>=(const Fraction &other) const
-{
-    // Convert both fractions to float values
-    float val = to_float();
-    float otherVal = other.to_float();
-
-    // Compare the float values and return the result
-    return (val >= otherVal);
-}
-
 /**
  * @brief Operator overload for comparison of a fraction and a float.
  *
  * @param other The float to compare to.
  * @return true if this fraction is greater than or equal to the float, false otherwise.
  */
-bool Fraction::operator>=(float other)
+template <typename IntT, typename Precision>
+bool BasicFraction<IntT, Precision>::operator>=(float other) const
 {
-    // Error handling for zero denominator
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-
     // Convert the fraction to a float value
     float val = to_float();
 
@@ -770,43 +842,15 @@ bool Fraction::operator>=(float other)
     return (val >= other);
 }
 
-/**
- * @brief Operator overload for comparison of two fractions.
- *
- * @param other The other fraction to compare to.
- * @return true if this fraction is less than or equal to the other fraction, false otherwise.
- */
-bool Fraction::operator<=(const Fraction &other) const
-{
-    // Error handling for zero denominators in both fractions
-    if (denominator == 0 || other.denominator == 0)
-    {
-        error_zero();
-    }
-
-    // Convert both fractions to float values
-    float val = to_float();
-    float otherVal = other.to_float();
-
-    // Compare the float values and return the result
-    return (val <= otherVal);
-}
-
 /**
  * Check if the fraction is less than or equal to a given float value.
  *
  * @param other The float value to compare with.
  * @return True if the fraction is less than or equal to the given float value, false otherwise.
- * @throws ZeroDenominatorError if the denominator is zero.
  */
-bool Fraction::operator<=(float other)
+template <typename IntT, typename Precision>
+bool BasicFraction<IntT, Precision>::operator<=(float other) const
 {
-    // Error handling for zero denominator
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-
     // Convert the fraction to a float value
     float val = to_float();
 
@@ -819,10 +863,30 @@ bool Fraction::operator<=(float other)
  *
  * @return A string representation of the fraction in the format "numerator/denominator".
  */
-Fraction::operator std::string() const
+template <typename IntT, typename Precision>
+BasicFraction<IntT, Precision>::operator std::string() const
 {
 
-    return std::to_string(numerator) + "/" + std::to_string(denominator);
+    return to_decimal(numerator) + "/" + to_decimal(denominator);
+}
+
+/**
+ * @brief Writes the fraction as "numerator/denominator", with the sign on the numerator.
+ *
+ * @param out A buffer with room for max_chars characters.
+ * @return A pointer past the last character written.
+ */
+template <typename IntT, typename Precision>
+char *BasicFraction<IntT, Precision>::format_to(char *out) const noexcept
+{
+    // The sign is already on the numerator; its magnitude is printed unsigned, so the minimum cannot overflow
+    if (numerator < 0)
+    {
+        *out++ = '-';
+    }
+    out = format_unsigned(out, magnitude(numerator));
+    *out++ = '/';
+    return format_unsigned(out, static_cast<UInt>(denominator));
 }
 
 // help functions
@@ -832,7 +896,8 @@ Fraction::operator std::string() const
  *
  * @return The current time in milliseconds.
  */
-long long int Fraction::get_time()
+template <typename IntT, typename Precision>
+long long int BasicFraction<IntT, Precision>::get_time()
 {
     return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
@@ -842,7 +907,8 @@ long long int Fraction::get_time()
  *
  * @return The current time in microseconds.
  */
-long long int Fraction::get_time_micro()
+template <typename IntT, typename Precision>
+long long int BasicFraction<IntT, Precision>::get_time_micro()
 {
     return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 }
@@ -853,118 +919,19 @@ long long int Fraction::get_time_micro()
  *
  * @param message The message to print.
  */
-void Fraction::print_message(std::string message)
+template <typename IntT, typename Precision>
+void BasicFraction<IntT, Precision>::print_message(std::string message)
 {
     std::cout << message << std::endl;
 }
 
-// Getters
-/**
- * Get the numerator of the fraction.
- *
- * @return The numerator of the fraction.
- * @throws ZeroDenominatorError if the denominator is zero.
- */
-int ariel::Fraction::getNumerator() const
-{
-    // Error handling for zero denominator
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-    return numerator;
-}
-
-/**
- * Get the denominator of the fraction.
- *
- * @return The denominator of the fraction.
- * @throws ZeroDenominatorError if the denominator is zero.
- */
-int ariel::Fraction::getDenominator() const
-{
-    // Error handling for zero denominator
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-    return denominator;
-}
-
-// To double
-/**
- * Convert the fraction to a double value.
- *
- * @return The fraction as a double value.
- * @throws ZeroDenominatorError if the denominator is zero.
- */
-double ariel::Fraction::to_double() const
-{
-    // Error handling for zero denominator
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-    return static_cast<double>(numerator) / static_cast<double>(denominator);
-}
-
-/**
- * Convert the fraction to an integer value.
- *
- * @return The fraction as an integer value.
- * @throws ZeroDenominatorError if the denominator is zero.
- */
-int ariel::Fraction::to_int() const
-{
-    // Error handling for zero denominator
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-    return numerator / denominator;
-}
-
 // Other methods
 
-/**
- * @brief Reduces the numerator and denominator of the fraction to their simplest form.
- *
- * @param numerator The numerator of the fraction to reduce.
- * @param denominator The denominator of the fraction to reduce.
- *
- * @throws std::runtime_error if the denominator is zero.
- */
-void Fraction::reduce(int &numerator, int &denominator)
-{
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-
-    // Check if the numerator or denominator is negative
-    bool nflag = numerator < 0;
-    bool dflag = denominator < 0;
-
-    // Make both numerator and denominator positive for simplification
-    numerator *= (nflag) ? -1 : 1;
-    denominator *= (dflag) ? -1 : 1;
-
-    // Calculate the greatest common divisor (GCD) using std::__gcd
-    int gcd = std::__gcd(numerator, denominator);
-
-    // Divide both numerator and denominator by their GCD
-    numerator /= gcd;
-    denominator /= gcd;
-
-    // Restore the original signs if necessary
-    numerator *= (nflag) ? -1 : 1;
-    denominator *= (dflag) ? -1 : 1;
-}
-
 /**
  * @brief Throws a runtime_error with the message "Can't divide by zero".
  */
-void Fraction::error_zero()
+template <typename IntT, typename Precision>
+void BasicFraction<IntT, Precision>::error_zero()
 {
     throw std::runtime_error("Can't divide by zero");
 }
@@ -972,7 +939,8 @@ void Fraction::error_zero()
 /**
  * @brief Throws a runtime_error with the message "Invalid input".
  */
-void Fraction::error_invalid()
+template <typename IntT, typename Precision>
+void BasicFraction<IntT, Precision>::error_invalid()
 {
     throw std::runtime_error("Invalid input");
 }
@@ -980,23 +948,17 @@ void Fraction::error_invalid()
 /**
  * @brief Throws an overflow_error with the message "Overflow".
  */
-void Fraction::error_overflow()
+template <typename IntT, typename Precision>
+void BasicFraction<IntT, Precision>::error_overflow()
 {
     throw std::overflow_error("Overflow");
 }
 
-/**
- * @brief Converts the fraction to a float value.
- *
- * @return The float representation of the fraction.
- *
- * @throws std::runtime_error if the denominator is zero.
- */
-float Fraction::to_float() const
-{
-    if (denominator == 0)
-    {
-        error_zero();
-    }
-    return static_cast<float>(numerator) / static_cast<float>(denominator);
-}
+// Compile the out-of-line members for every supported width
+template class ariel::BasicFraction<std::int8_t>;
+template class ariel::BasicFraction<std::int16_t>;
+template class ariel::BasicFraction<int>;
+template class ariel::BasicFraction<std::int64_t>;
+template class ariel::BasicFraction<__int128>;
+template class ariel::BasicFraction<int, ariel::DecimalPrecision<2>>;
+template class ariel::BasicFraction<int, ariel::DecimalPrecision<6>>;
@@ -14,53 +14,162 @@
 #define FRACTION_HPP
 
 #include <algorithm> // For algorithmic operations
+#include <cassert>   // For the invariant checks of debug builds
 #include <iostream>  // For input/output streams
 #include <limits>    // For numeric limits
 #include <math.h>    // For mathematical functions
 #include <numeric>   // For numeric operations
 #include <stdexcept> // For standard exceptions
 #include <string>    // For string operations
+#include <type_traits> // For std::is_constant_evaluated
 #include <unistd.h>  // For POSIX API
 #include <chrono>    // For time-related functions
+#include "FractionLog.hpp"    // For compile-time switchable logging
+#include "FractionTraits.hpp" // For the per-width term types and limits
+#include "Gcd.hpp"            // For the GCD engines used by reduce
 
 using namespace std;
 
 namespace ariel
 {
-    float const FACTOR = 1000;
+    /**
+     * @brief The precision of a fraction's float interoperation: floats are converted to Decimals decimal
+     * places, and the mixed operators are then exact.
+     *
+     * The scale is a compile-time integer, so every instantiation gets its own code with the scaling and the
+     * rounding done by constants in integer arithmetic. A finer precision gives floats that do not reduce
+     * larger terms: with int terms and 6 decimals 0.1234567f is 123457/1000000, and adding 1/3001 overflows.
+     */
+    template <int Decimals>
+    struct DecimalPrecision
+    {
+        static_assert(Decimals >= 0 && Decimals <= 9, "DecimalPrecision supports 0 to 9 decimal places");
+
+        static constexpr int decimals = Decimals;
+
+        // 10^Decimals
+        static constexpr std::int64_t scale = []
+        {
+            std::int64_t power = 1;
+            for (int i = 0; i < Decimals; ++i)
+            {
+                power *= 10;
+            }
+            return power;
+        }();
+    };
+
+    // Three decimal places, the precision Fraction has always used
+    using DefaultPrecision = DecimalPrecision<3>;
+
+    // The scale of the default precision, for code written before the precision became a parameter
+    float const FACTOR = DefaultPrecision::scale;
 
-    class Fraction
+    /**
+     * @brief How BasicFraction::from_double converts a floating-point value.
+     */
+    enum class FloatConversion
+    {
+        Truncate,   // Scale to the fraction's precision and truncate, as the float and double constructors do
+        Exact,      // The exact value of the binary floating-point number
+        Approximate // The closest fraction whose denominator does not exceed a bound
+    };
+
+    /**
+     * @brief Why a checked operation has no result.
+     */
+    enum class FractionError
+    {
+        None,            // The operation succeeded
+        ZeroDenominator, // A fraction was given a zero denominator
+        DivideByZero,    // The divisor is zero
+        Overflow,        // The result does not fit in the terms
+        InvalidInput     // The input is not a fraction
+    };
+
+    /**
+     * @brief The outcome of a checked operation, in the manner of std::expected: the value, or the error that
+     * prevented it. On failure the value is default constructed.
+     */
+    template <typename T>
+    struct Checked
+    {
+        T value{};
+        FractionError error = FractionError::None;
+
+        constexpr bool ok() const noexcept { return error == FractionError::None; }
+        constexpr explicit operator bool() const noexcept { return ok(); }
+    };
+
+    /**
+     * @brief A fraction whose numerator and denominator are stored in the signed integer type IntT.
+     *
+     * IntT may be any signed integer of 8, 16, 32, 64 or 128 bits; Fraction is the int instantiation.
+     * Intermediate products are computed in FractionTraits<IntT>::wide_type and every result is checked
+     * against the range of IntT before it is stored.
+     *
+     * Every fraction is canonical: its terms are reduced and its denominator is positive, so the sign is on
+     * the numerator. The constructors establish this once and every operation preserves it, so nothing
+     * that reads the terms has to check or normalize them. Debug builds assert it whenever a fraction is
+     * made.
+     *
+     * Precision is a DecimalPrecision that sets how many decimal places the float constructors and the float
+     * operands of the mixed operators keep.
+     */
+    template <typename IntT, typename Precision = DefaultPrecision>
+    class BasicFraction
     {
     private:
+        using Traits = FractionTraits<IntT>;
+        using UInt = typename Traits::unsigned_type;
+        using Wide = typename Traits::wide_type;
+
+        // Twice a scaled term must fit in the wide type, for scaled_round. 128-bit terms compare exactly.
+        static_assert(!Traits::widens || Precision::scale <= FractionTraits<Wide>::max_value / 2 / Traits::max_value,
+                      "The precision is too fine for the width of the terms");
+
         // Private methods - used by the class only
-        int numerator;                        // The numerator of the fraction - always positive
-        bool is_negative;                     // Is the fraction negative - true if negative, false if positive
-        int denominator;                      // The denominator of the fraction - always positive
-        void log(const std::string &message); // Prints a message to the console
+        IntT numerator = 0;   // The numerator of the fraction
+        IntT denominator = 1; // The denominator of the fraction - always positive
+
+        // Asserts the canonical form in debug builds
+        constexpr void check_invariant() const noexcept
+        {
+            assert(denominator > 0 && gcd::compute(magnitude(numerator), static_cast<UInt>(denominator)) == 1);
+        }
+
+        // Logs a trace message - compiled out unless FRACTION_LOG_LEVEL enables tracing
+        static constexpr void log(const char *message) noexcept
+        {
+            if (!std::is_constant_evaluated())
+            {
+                logging::log<logging::Level::Trace>(message);
+            }
+        }
 
     public:
         // Constructors and destructor - used by the user
-        Fraction(int numerator, int denominator); // int constructor
-        Fraction(float numerator);                // float constructor
-        Fraction(double numerator);               // double constructor
-        Fraction(Fraction const &other);          // copy constructor
-        Fraction();                               // default constructor
-        Fraction(Fraction &&other) noexcept;      // move constructor
-        ~Fraction() = default;
+        constexpr BasicFraction(IntT numerator, IntT denominator);              // integer constructor
+        BasicFraction(float numerator);                                         // float constructor
+        BasicFraction(double numerator);                                        // double constructor
+        constexpr BasicFraction(BasicFraction const &other) = default;          // copy constructor
+        constexpr BasicFraction() noexcept;                                     // default constructor
+        constexpr BasicFraction(BasicFraction &&other) noexcept = default;      // move constructor
+        ~BasicFraction() = default;
 
         // Operators for equality (=)
-        Fraction &operator=(Fraction &&other) noexcept; // move assignment operator
-        Fraction &operator=(const Fraction &other);     // copy assignment operator
-        Fraction &operator=(float other);               // float assignment operator
+        constexpr BasicFraction &operator=(BasicFraction &&other) noexcept = default; // move assignment operator
+        constexpr BasicFraction &operator=(const BasicFraction &other) = default;     // copy assignment operator
+        BasicFraction &operator=(float other);                                        // float assignment operator
 
         // Operators for addition (+)
-        Fraction operator+(const Fraction &other) const; // Fraction addition operator
-        Fraction operator+(float other);                 // float addition operator
-        Fraction operator+=(const Fraction &other);      // Fraction addition assignment operator
-        Fraction operator+=(float other);                // float addition assignment operator
-        Fraction &operator++();                          // Fraction prefix increment operator
-        const Fraction operator++(int);                  // Fraction postfix increment operator
-                                                         // Declaration of friend function
+        constexpr BasicFraction operator+(const BasicFraction &other) const; // Fraction addition operator
+        BasicFraction operator+(float other);                                // float addition operator
+        BasicFraction operator+=(const BasicFraction &other);                // Fraction addition assignment operator
+        BasicFraction operator+=(float other);                               // float addition assignment operator
+        BasicFraction &operator++();                                         // Fraction prefix increment operator
+        const BasicFraction operator++(int);                                 // Fraction postfix increment operator
+                                                                             // Declaration of friend function
 
         /**
          * @brief Addition operator for adding a float value to a Fraction.
@@ -71,24 +180,19 @@ namespace ariel
          * @param fraction The Fraction object to add to.
          * @return The result of the addition as a Fraction object.
          */
-        friend Fraction operator+(float other, const Fraction &fraction)
+        friend BasicFraction operator+(float other, const BasicFraction &fraction)
         {
-            // Calculate the addition of the float and the Fraction
-            float tmp1 = round(other * FACTOR) / FACTOR;
-            float tmp2 = round(fraction.to_float() * FACTOR) / FACTOR;
-            Fraction tmp(tmp1 + tmp2);
-
-            // Return the resulting Fraction
-            return tmp;
+            // Scale the float once, then add exactly
+            return fraction.plus_scaled(scale_float(other), false);
         }
 
         // Operators for subtraction (-)
-        Fraction operator-(const Fraction &other) const; // Fraction subtraction operator
-        Fraction operator-(float other);                 // Float subtraction operator
-        Fraction operator-=(const Fraction &other);      // Fraction subtraction assignment operator
-        Fraction operator-=(float other);                // Float subtraction assignment operator
-        Fraction &operator--();                          // Fraction prefix decrement operator
-        const Fraction operator--(int);                  // Fraction postfix decrement operator
+        constexpr BasicFraction operator-(const BasicFraction &other) const; // Fraction subtraction operator
+        BasicFraction operator-(float other);                                // Float subtraction operator
+        BasicFraction operator-=(const BasicFraction &other);                // Fraction subtraction assignment operator
+        BasicFraction operator-=(float other);                               // Float subtraction assignment operator
+        BasicFraction &operator--();                                         // Fraction prefix decrement operator
+        const BasicFraction operator--(int);                                 // Fraction postfix decrement operator
 
         /**
          * @brief Operator overload for subtraction of a float from a fraction.
@@ -105,15 +209,10 @@ namespace ariel
          * @param fraction The fraction to subtract from.
          * @return The result of the subtraction operation as a new Fraction.
          */
-        friend Fraction operator-(float other, const Fraction &fraction)
+        friend BasicFraction operator-(float other, const BasicFraction &fraction)
         {
-            // Calculate the subtraction of the float from the fraction
-            float tmp1 = round(other * FACTOR) / FACTOR;
-            float tmp2 = round(fraction.to_float() * FACTOR) / FACTOR;
-            Fraction tmp(tmp1 - tmp2);
-
-            // Return the resulting Fraction
-            return tmp;
+            // Scale the float once, then subtract exactly
+            return fraction.plus_scaled(scale_float(other), true);
         }
 
         // time func
@@ -139,10 +238,10 @@ namespace ariel
         void print_message(std::string message);
 
         // Operators for multiplication (*)
-        Fraction operator*(const Fraction &other) const; // Fraction multiplication operator
-        Fraction operator*(float other);                 // Float multiplication operator
-        Fraction operator*=(const Fraction &other);      // Fraction multiplication assignment operator
-        Fraction operator*=(float other);                // Float multiplication assignment operator
+        constexpr BasicFraction operator*(const BasicFraction &other) const; // Fraction multiplication operator
+        BasicFraction operator*(float other);                                // Float multiplication operator
+        BasicFraction operator*=(const BasicFraction &other);                // Fraction multiplication assignment operator
+        BasicFraction operator*=(float other);                               // Float multiplication assignment operator
         /**
          * @brief Multiplication operator for multiplying a float value by a Fraction.
          *
@@ -152,13 +251,10 @@ namespace ariel
          * @param fraction The Fraction object to multiply with.
          * @return The result of the multiplication as a Fraction object.
          */
-        friend Fraction operator*(float other, const Fraction &fraction)
+        friend BasicFraction operator*(float other, const BasicFraction &fraction)
         {
-            // Create a temporary Fraction object from the float value
-            Fraction tmp(other);
-
-            // Perform the multiplication and return the result
-            return tmp * fraction;
+            // Convert the float once, then multiply exactly
+            return float_operand(other) * fraction;
         }
 
         // Operators for division (/)
@@ -166,81 +262,81 @@ namespace ariel
         /**
          * @brief Operator overload for dividing a Fraction object by another Fraction object.
          */
-        Fraction operator/(const Fraction &other) const;
+        constexpr BasicFraction operator/(const BasicFraction &other) const;
 
         /**
          * @brief Operator overload for dividing a Fraction object by a float value.
          */
-        Fraction operator/(float other);
+        BasicFraction operator/(float other);
 
         /**
          * @brief Operator overload for dividing a Fraction object by another Fraction object and assigning the result to the current object.
          */
-        Fraction operator/=(const Fraction &other);
+        BasicFraction operator/=(const BasicFraction &other);
 
         /**
          * @brief Operator overload for dividing a Fraction object by a float value and assigning the result to the current object.
          */
-        Fraction operator/=(float other);
+        BasicFraction operator/=(float other);
 
         /**
          * @brief Friend function for dividing a float value by a Fraction object.
          */
-        friend Fraction operator/(float other, const Fraction &fraction)
+        friend BasicFraction operator/(float other, const BasicFraction &fraction)
         {
             // Check if the fraction is zero
-            if (fraction.to_float() == 0)
+            if (fraction.numerator == 0)
             {
                 error_zero();
             }
 
-            // Create a temporary Fraction object from the float value
-            Fraction tmp(other);
-
-            // Perform the division and return the result
-            return tmp / fraction;
+            // Convert the float once, then divide exactly
+            return float_operand(other) / fraction;
         }
 
         // Operators for equality-checking (==, !=)
 
         /**
          * @brief Operator overload for checking if two Fraction objects are equal.
+         *
+         * Fractions are equal if they have the same value, exactly, at every width, as for the other
+         * comparisons.
          */
-        bool operator==(const Fraction &other) const;
+        constexpr bool operator==(const BasicFraction &other) const noexcept;
 
         /**
          * @brief Operator overload for checking if a Fraction object is equal to a float value.
          */
-        bool operator==(float other);
+        bool operator==(float other) const;
 
         /**
-         * @brief Operator overload for checking if a float value is equal to a Fraction object.
+         * @brief Operator overload for checking if a float value is equal to a Fraction object. The same as
+         * fraction == other.
          */
-        friend bool operator==(float other, const Fraction &fraction)
+        friend bool operator==(float other, const BasicFraction &fraction)
         {
-            return other == fraction.to_float();
+            return fraction == other;
         }
 
         /**
          * @brief Operator overload for checking if two Fraction objects are not equal.
          */
-        bool operator!=(const Fraction &other) const;
+        constexpr bool operator!=(const BasicFraction &other) const noexcept;
 
         /**
          * @brief Operator overload for checking if a Fraction object is not equal to a float value.
          */
-        bool operator!=(float other);
+        bool operator!=(float other) const;
 
         /**
-         * @brief Operator overload for checking if a float value is not equal to a Fraction object.
+         * @brief Operator overload for checking if a float value is not equal to a Fraction object. The same as
+         * fraction != other.
+         *
+         * @throws std::runtime_error if other is zero.
          */
-        friend bool operator!=(float other, const Fraction &fraction)
+        friend bool operator!=(float other, const BasicFraction &fraction)
         {
-            if (fraction.to_float() == 0)
-            {
-                error_zero();
-            }
-            return other != fraction.to_float();
+            return fraction != other;
         }
 
         // Operators for inequality (>, <, >=, <=)
@@ -249,13 +345,12 @@ namespace ariel
          * @brief Operator overload for the greater than operator (>) between two fractions.
          *
          * This operator compares the current fraction with another fraction to determine if the current fraction
-         * is greater than the other fraction. It uses the float representation of the fractions for the comparison.
+         * is greater than the other fraction.
          *
          * @param other The other fraction to compare to.
          * @return true if the current fraction is greater than the other fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator>(const Fraction &other) const;
+        constexpr bool operator>(const BasicFraction &other) const noexcept;
 
         /**
          * @brief Operator overload for the greater than operator (>) between a fraction and a float.
@@ -267,39 +362,33 @@ namespace ariel
          * @return true if the current fraction is greater than the float value, false otherwise.
          * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator>(float other);
+        bool operator>(float other) const;
 
         /**
          * @brief Friend operator overload for the greater than operator (>) between a float and a fraction.
          *
          * This operator compares a float value with a fraction to determine if the float value is greater than the fraction.
-         * It uses the float representation of the fraction for the comparison.
+         * It is the same as fraction < other, so both argument orders agree.
          *
          * @param other The float value to compare to.
          * @param fraction The fraction to compare with the float value.
          * @return true if the float value is greater than the fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        friend bool operator>(float other, const Fraction &fraction)
+        friend bool operator>(float other, const BasicFraction &fraction)
         {
-            if (fraction.to_float() == 0)
-            {
-                error_zero();
-            }
-            return other > fraction.to_float();
+            return fraction < other;
         }
 
         /**
          * @brief Operator overload for the less than operator (<) between two fractions.
          *
          * This operator compares the current fraction with another fraction to determine if the current fraction
-         * is less than the other fraction. It uses the float representation of the fractions for the comparison.
+         * is less than the other fraction.
          *
          * @param other The other fraction to compare to.
          * @return true if the current fraction is less than the other fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator<(const Fraction &other) const;
+        constexpr bool operator<(const BasicFraction &other) const noexcept;
 
         /**
          * @brief Operator overload for the less than operator (<) between a fraction and a float.
@@ -311,39 +400,34 @@ namespace ariel
          * @return true if the current fraction is less than the float value, false otherwise.
          * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator<(float other);
+        bool operator<(float other) const;
 
         /**
          * @brief Friend operator overload for the less than operator (<) between a float and a fraction.
          *
          * This operator compares a float value with a fraction to determine if the float value is less than the fraction.
-         * It uses the float representation of the fraction for the comparison.
+         * It is the same as fraction > other, so both argument orders agree.
          *
          * @param other The float value to compare to.
          * @param fraction The fraction to compare with the float value.
          * @return true if the float value is less than the fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
+         * @throws std::runtime_error if other is zero.
          */
-        friend bool operator<(float other, const Fraction &fraction)
+        friend bool operator<(float other, const BasicFraction &fraction)
         {
-            if (fraction.to_float() == 0)
-            {
-                error_zero();
-            }
-            return other < fraction.to_float();
+            return fraction > other;
         }
 
         /**
          * @brief Operator overload for the greater than or equal to operator (>=) between two fractions.
          *
          * This operator compares the current fraction with another fraction to determine if the current fraction
-         * is greater than or equal to the other fraction. It uses the float representation of the fractions for the comparison.
+         * is greater than or equal to the other fraction.
          *
          * @param other The other fraction to compare to.
          * @return true if the current fraction is greater than or equal to the other fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator>=(const Fraction &other) const;
+        constexpr bool operator>=(const BasicFraction &other) const noexcept;
 
         /**
          * @brief Operator overload for the greater than or equal to operator (>=) between a fraction and a float.
@@ -355,39 +439,33 @@ namespace ariel
          * @return true if the current fraction is greater than or equal to the float value, false otherwise.
          * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator>=(float other);
+        bool operator>=(float other) const;
 
         /**
          * @brief Friend operator overload for the greater than or equal to operator (>=) between a float and a fraction.
          *
          * This operator compares a float value with a fraction to determine if the float value is greater than or equal to the fraction.
-         * It uses the float representation of the fraction for the comparison.
+         * It is the same as fraction <= other, so both argument orders agree.
          *
          * @param other The float value to compare to.
          * @param fraction The fraction to compare with the float value.
          * @return true if the float value is greater than or equal to the fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        friend bool operator>=(float other, const Fraction &fraction)
+        friend bool operator>=(float other, const BasicFraction &fraction)
         {
-            if (fraction.to_float() == 0)
-            {
-                error_zero();
-            }
-            return other >= fraction.to_float();
+            return fraction <= other;
         }
 
         /**
          * @brief Operator overload for the less than or equal to operator (<=) between two fractions.
          *
          * This operator compares the current fraction with another fraction to determine if the current fraction
-         * is less than or equal to the other fraction. It uses the float representation of the fractions for the comparison.
+         * is less than or equal to the other fraction.
          *
          * @param other The other fraction to compare to.
          * @return true if the current fraction is less than or equal to the other fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator<=(const Fraction &other) const;
+        constexpr bool operator<=(const BasicFraction &other) const noexcept;
 
         /**
          * @brief Operator overload for the less than or equal to operator (<=) between a fraction and a float.
@@ -399,71 +477,108 @@ namespace ariel
          * @return true if the current fraction is less than or equal to the float value, false otherwise.
          * @throws std::runtime_error if the denominator is zero.
          */
-        bool operator<=(float other);
+        bool operator<=(float other) const;
 
         /**
          * @brief Friend operator overload for the less than or equal to operator (<=) between a float and a fraction.
          *
          * This operator compares a float value with a fraction to determine if the float value is less than or equal to the fraction.
-         * It uses the float representation of the fraction for the comparison.
+         * It is the same as fraction >= other, so both argument orders agree.
          *
          * @param other The float value to compare to.
          * @param fraction The fraction to compare with the float value.
          * @return true if the float value is less than or equal to the fraction, false otherwise.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        friend bool operator<=(float other, const Fraction &fraction)
+        friend bool operator<=(float other, const BasicFraction &fraction)
         {
-            if (fraction.to_float() == 0)
-            {
-                error_zero();
-            }
-            return other <= fraction.to_float();
+            return fraction >= other;
         }
 
-        // Getters
-        int getNumerator() const;
-        int getDenominator() const;
+        /**
+         * @brief Exact three-way comparison of two fractions, which the comparison operators use.
+         *
+         * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+         */
+        static constexpr int compare(const BasicFraction &lhs, const BasicFraction &rhs) noexcept;
+
+        /**
+         * @brief Checked arithmetic: the result of lhs + rhs, lhs - rhs, lhs * rhs or lhs / rhs, or the error
+         * that prevented it, without throwing.
+         *
+         * The error is Overflow if the result does not fit in IntT, and DivideByZero for a zero divisor. The
+         * operators +, -, * and / call these and throw on an error, so both give the same results.
+         */
+        static constexpr Checked<BasicFraction> checked_add(const BasicFraction &lhs, const BasicFraction &rhs) noexcept;
+        static constexpr Checked<BasicFraction> checked_sub(const BasicFraction &lhs, const BasicFraction &rhs) noexcept;
+        static constexpr Checked<BasicFraction> checked_mul(const BasicFraction &lhs, const BasicFraction &rhs) noexcept;
+        static constexpr Checked<BasicFraction> checked_div(const BasicFraction &lhs, const BasicFraction &rhs) noexcept;
+
+        /**
+         * @brief Checked construction: the canonical fraction numerator/denominator, ZeroDenominator, or
+         * Overflow, without throwing.
+         */
+        static constexpr Checked<BasicFraction> checked_make(IntT numerator, IntT denominator) noexcept;
+
+        // Getters - the terms are canonical, so these are plain loads
+        constexpr IntT getNumerator() const noexcept { return numerator; }
+        constexpr IntT getDenominator() const noexcept { return denominator; }
         // To string
         operator std::string() const;
         // To double
-        double to_double() const;
-        // To int
-        int to_int() const;
+        constexpr double to_double() const noexcept { return static_cast<double>(numerator) / static_cast<double>(denominator); }
+        // To int, truncated toward zero
+        constexpr IntT to_int() const noexcept { return static_cast<IntT>(numerator / denominator); }
+
+        /**
+         * @brief Converts a floating-point value with the chosen conversion.
+         *
+         * Truncate is the constructor's conversion, to the fraction's precision. Exact decomposes the value into its
+         * binary mantissa and exponent, so 0.375 is 3/8 and 0.1 is 3602879701896397/36028797018963968, which
+         * fits only in 64-bit terms and wider. Approximate walks the continued fraction of the exact value
+         * and returns the best rational approximation with a denominator of at most max_denominator,
+         * e.g. 355/113 for pi with max_denominator 1000.
+         *
+         * @param value The value to convert.
+         * @param conversion The conversion to apply.
+         * @param max_denominator The largest denominator Approximate may return; ignored otherwise.
+         * @throws std::runtime_error if the value is not finite.
+         * @throws std::invalid_argument if max_denominator is not positive.
+         * @throws std::overflow_error if the result does not fit in IntT.
+         */
+        static BasicFraction from_double(double value, FloatConversion conversion, IntT max_denominator = Traits::max_value);
+
+        // The longest text format_to writes: a sign, both terms and the slash
+        static constexpr std::size_t max_chars = 2 * Traits::max_digits + 2;
+
+        /**
+         * @brief Writes the fraction as "numerator/denominator" to out, with the sign on the numerator,
+         * without a terminator and without going through a stream.
+         *
+         * @param out A buffer with room for max_chars characters.
+         * @return A pointer past the last character written.
+         */
+        char *format_to(char *out) const noexcept;
+
         // Stream operators
 
         /**
          * @brief Overload of the stream insertion operator (<<) for Fraction objects.
          *
          * This operator allows a Fraction object to be inserted into an output stream, such as std::cout,
-         * in the format "numerator/denominator". The fraction is displayed in its simplest form, with the
-         * negative sign applied to the numerator if the denominator is negative.
+         * in the format "numerator/denominator". The fraction is displayed in its canonical form, with the
+         * sign on the numerator. The text is formatted by
+         * format_to and written with a single ostream::write, bypassing the locale machinery.
          *
          * @param ostrm The output stream to insert the Fraction into.
          * @param fraction The Fraction object to insert.
          * @return The modified output stream after inserting the Fraction.
-         * @throws std::runtime_error if the denominator is zero.
          */
-        friend std::ostream &operator<<(std::ostream &ostrm, const Fraction &fraction)
+        friend std::ostream &operator<<(std::ostream &ostrm, const BasicFraction &fraction)
         {
-            // Check if the denominator is zero
-            if (fraction.getDenominator() == 0)
-            {
-                error_zero();
-            }
-
-            int num = fraction.getNumerator();
-            int denom = fraction.getDenominator();
-
-            // Adjust the sign of the numerator if the denominator is negative
-            if (denom < 0)
-            {
-                num = -num;
-                denom = -denom;
-            }
-
-            // Output the fraction in the format "numerator/denominator"
-            ostrm << num << "/" << denom;
+            // Render into a stack buffer and hand it to the stream in one write
+            char buffer[max_chars];
+            char *end = fraction.format_to(buffer);
+            ostrm.write(buffer, end - buffer);
             return ostrm;
         }
 
@@ -480,14 +595,14 @@ namespace ariel
          * @return The modified input stream after extracting the Fraction.
          * @throws std::runtime_error if the input is invalid or the denominator is zero.
          */
-        friend std::istream &operator>>(std::istream &istrm, Fraction &fraction)
+        friend std::istream &operator>>(std::istream &istrm, BasicFraction &fraction)
         {
-            int numerator = 0;
-            int denominator = 1;
+            IntT numerator = 0;
+            IntT denominator = 1;
             char slash = 0;
 
             // Read the numerator from the input stream
-            istrm >> numerator;
+            read_integer(istrm, numerator);
 
             // Check for input failure or a zero denominator
             if (istrm.fail() || denominator == 0)
@@ -499,7 +614,8 @@ namespace ariel
             if (istrm.peek() == '/')
             {
                 // Read the slash and the denominator from the input stream
-                istrm >> slash >> denominator;
+                istrm >> slash;
+                read_integer(istrm, denominator);
 
                 // Check for input failure or a zero denominator
                 if (istrm.fail() || denominator == 0)
@@ -510,7 +626,7 @@ namespace ariel
             else
             {
                 // If the next character is not a slash, assume the denominator is provided separately
-                istrm >> denominator;
+                read_integer(istrm, denominator);
 
                 // Check for input failure or a zero denominator
                 if (istrm.fail() || denominator == 0)
@@ -520,7 +636,7 @@ namespace ariel
             }
 
             // Create a new Fraction object with the extracted numerator and denominator
-            fraction = Fraction(numerator, denominator);
+            fraction = BasicFraction(numerator, denominator);
             return istrm;
         }
 
@@ -531,11 +647,144 @@ namespace ariel
          *
          * This method reduces the fraction to its simplest form by dividing both the numerator and denominator
          * by their greatest common divisor (GCD). It modifies the numerator and denominator variables in place.
+         * T is IntT, or the wide type for values that are only narrowed after reduction. The denominator must
+         * be positive, so the numerator keeps its sign.
          *
          * @param numerator The numerator of the fraction.
          * @param denominator The denominator of the fraction.
          */
-        static void reduce(int &numerator, int &denominator);
+        template <typename T>
+        static constexpr void reduce(T &numerator, T &denominator) noexcept;
+
+        /**
+         * @brief Returns the absolute value of a signed integer as its unsigned type, without overflow for the minimum.
+         */
+        template <typename T>
+        static constexpr typename FractionTraits<T>::unsigned_type magnitude(T value) noexcept;
+
+        /**
+         * @brief Returns the greatest common divisor of the magnitudes of two terms, in the wide type.
+         */
+        static constexpr Wide common_factor(IntT first, IntT second) noexcept;
+
+        /**
+         * @brief Multiplies two terms in the wide type. Without a wider type the product is overflow-checked.
+         *
+         * @return false if the product does not fit in the wide type.
+         */
+        static constexpr bool wide_multiply(IntT first, IntT second, Wide &product) noexcept;
+
+        /**
+         * @brief Adds two wide values, checking for overflow.
+         *
+         * @return false if the sum does not fit in the wide type.
+         */
+        static constexpr bool wide_add(Wide first, Wide second, Wide &sum) noexcept;
+
+        /**
+         * @brief Subtracts two wide values, checking for overflow.
+         *
+         * @return false if the difference does not fit in the wide type.
+         */
+        static constexpr bool wide_subtract(Wide first, Wide second, Wide &difference) noexcept;
+
+        /**
+         * @brief Returns true if a wide value fits in IntT.
+         */
+        static constexpr bool fits(Wide value) noexcept;
+
+        /**
+         * @brief Converts a wide value back to a term.
+         *
+         * @throws std::overflow_error if the value does not fit in IntT.
+         */
+        static constexpr IntT narrow(Wide value);
+
+        /**
+         * @brief The sum, or with Subtract the difference, of two fractions by Knuth's algorithm: the cross
+         * products use the denominators divided by their GCD, so every intermediate is at most the size of
+         * the terms of the result. Shared by checked_add and checked_sub.
+         */
+        template <bool Subtract>
+        static constexpr Checked<BasicFraction> checked_sum(const BasicFraction &lhs, const BasicFraction &rhs) noexcept;
+
+        /**
+         * @brief Returns the fraction numerator/denominator in reduced form, without the constructor's checks.
+         * The denominator must be positive.
+         */
+        static constexpr BasicFraction reduced(IntT numerator, IntT denominator) noexcept;
+
+        /**
+         * @brief Returns the value of a checked result, or throws the exception its error stands for.
+         *
+         * @throws std::invalid_argument for ZeroDenominator.
+         * @throws std::runtime_error for DivideByZero and InvalidInput.
+         * @throws std::overflow_error for Overflow.
+         */
+        static constexpr BasicFraction unwrap(const Checked<BasicFraction> &result);
+
+        /**
+         * @brief Compares a/b with c/d for positive terms by their continued fraction expansions, without
+         * multiplying. Used when there is no wider type to cross-multiply in.
+         *
+         * @return A negative value if a/b < c/d, zero if they are equal, and a positive value if a/b > c/d.
+         */
+        static constexpr int compare_magnitudes(UInt a, UInt b, UInt c, UInt d) noexcept;
+
+        /**
+         * @brief Computes numerator / denominator * Precision::scale rounded half away from zero, exactly.
+         *
+         * @param numerator The numerator of the fraction.
+         * @param denominator The denominator of the fraction - must not be zero.
+         * @return The scaled and rounded value.
+         */
+        static constexpr Wide scaled_round(Wide numerator, Wide denominator) noexcept;
+
+        /**
+         * @brief Computes this fraction * Precision::scale rounded half away from zero.
+         *
+         * @throws std::overflow_error if 128-bit terms are too large to scale.
+         */
+        Wide scaled_value() const;
+
+        /**
+         * @brief Computes value * Precision::scale rounded half away from zero.
+         *
+         * @throws std::runtime_error if value is NaN.
+         * @throws std::overflow_error if value is out of the range of IntT.
+         */
+        static Wide scale_float(float value);
+
+        /**
+         * @brief Converts the float operand of a mixed operation: the value rounded to the precision, as an
+         * exact fraction.
+         *
+         * @throws std::runtime_error if value is NaN.
+         * @throws std::overflow_error if value is out of range, or its reduced terms do not fit in IntT.
+         */
+        static BasicFraction float_operand(float value);
+
+        /**
+         * @brief Returns the fraction scaled / Precision::scale, reduced.
+         *
+         * @throws std::overflow_error if the reduced terms do not fit in IntT.
+         */
+        static BasicFraction from_scaled(Wide scaled);
+
+        /**
+         * @brief Returns scaled / Precision::scale plus this fraction, or minus it if negate, exactly.
+         *
+         * @throws std::overflow_error if the reduced terms do not fit in IntT.
+         */
+        BasicFraction plus_scaled(Wide scaled, bool negate) const;
+
+        /**
+         * @brief Returns this fraction divided by scaled / Precision::scale, exactly.
+         *
+         * @param scaled The divisor scaled by Precision::scale - must not be zero.
+         * @throws std::overflow_error if the reduced terms do not fit in IntT.
+         */
+        BasicFraction over_scaled(Wide scaled) const;
 
         /**
          * @brief Throws a runtime_error with the message "Can't divide by zero".
@@ -556,12 +805,707 @@ namespace ariel
          * @brief Converts the fraction to a float value.
          *
          * @return The float representation of the fraction.
-         *
-         * @throws std::runtime_error if the denominator is zero.
          */
-        float to_float() const;
+        constexpr float to_float() const noexcept { return static_cast<float>(numerator) / static_cast<float>(denominator); }
     };
 
+
+    /**
+     * @brief The fraction type with int terms.
+     */
+    using Fraction = BasicFraction<int>;
+
+    /**
+     * @brief The fraction type with int terms and Decimals decimal places of float precision. Fractions with 2
+     * and 6 decimals are compiled in; Fraction is DecimalFraction<3>.
+     */
+    template <int Decimals>
+    using DecimalFraction = BasicFraction<int, DecimalPrecision<Decimals>>;
+
+    // Inline definitions - the arithmetic core is constexpr so it can be inlined and constant-folded
+
+    /**
+     * @brief Constructs a new Fraction object with the given numerator and denominator.
+     *
+     * The fraction is stored in canonical form: reduced, with the sign on the numerator.
+     *
+     * @param input_numerator The numerator of the fraction.
+     * @param input_denominator The denominator of the fraction.
+     *
+     * @throws std::invalid_argument if the denominator is zero.
+     * @throws std::overflow_error if the canonical terms do not fit in IntT, as for 1/INT_MIN.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision>::BasicFraction(IntT input_numerator, IntT input_denominator)
+    {
+        if (input_denominator == 0)
+        {
+            // Throw an exception if the denominator is zero
+            throw std::invalid_argument("Denominator can't be zero");
+        }
+
+        // Log a message indicating the creation of a fraction from integer numerator and denominator
+        log("Creating fraction from int numerator and denominator");
+
+        // Canonicalize without throwing, then report the one error left
+        Checked<BasicFraction> result = checked_make(input_numerator, input_denominator);
+        if (!result)
+        {
+            error_overflow();
+        }
+        numerator = result.value.numerator;
+        denominator = result.value.denominator;
+    }
+
+    /**
+     * @brief Default constructor for Fraction objects.
+     *
+     * Sets the numerator to 0 and the denominator to 1.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision>::BasicFraction() noexcept
+    {
+        log("Creating fraction from default constructor");
+    }
+
+    /**
+     * @brief Adds two fractions.
+     *
+     * @param other The fraction to add.
+     * @return The sum in reduced form.
+     * @throws std::overflow_error if the result does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator+(const BasicFraction &other) const
+    {
+        return unwrap(checked_add(*this, other));
+    }
+
+    /**
+     * @brief Operator overload for subtraction of another fraction from this fraction.
+     *
+     * @param other The other fraction to subtract from this fraction.
+     * @return A new Fraction object that is the result of the subtraction.
+     * @throws std::overflow_error if the result does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator-(const BasicFraction &other) const
+    {
+        return unwrap(checked_sub(*this, other));
+    }
+
+    /**
+     * @brief Multiplies two fractions.
+     *
+     * @param other The fraction to multiply by.
+     * @return The product in reduced form.
+     * @throws std::overflow_error if the result does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator*(const BasicFraction &other) const
+    {
+        return unwrap(checked_mul(*this, other));
+    }
+
+    /**
+     * @brief Operator overload for division of two fractions.
+     *
+     * @param other The other fraction to divide by.
+     * @return The result of dividing the fractions.
+     * @throws std::runtime_error if other is zero.
+     * @throws std::overflow_error if the result does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::operator/(const BasicFraction &other) const
+    {
+        return unwrap(checked_div(*this, other));
+    }
+
+    /**
+     * @brief Adds two fractions without throwing.
+     *
+     * @param lhs The left-hand fraction.
+     * @param rhs The right-hand fraction.
+     * @return The sum in reduced form, or Overflow if it does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr Checked<BasicFraction<IntT, Precision>> BasicFraction<IntT, Precision>::checked_add(const BasicFraction &lhs, const BasicFraction &rhs) noexcept
+    {
+        return checked_sum<false>(lhs, rhs);
+    }
+
+    /**
+     * @brief Subtracts one fraction from another without throwing.
+     *
+     * @param lhs The fraction to subtract from.
+     * @param rhs The fraction to subtract.
+     * @return The difference in reduced form, or Overflow if it does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr Checked<BasicFraction<IntT, Precision>> BasicFraction<IntT, Precision>::checked_sub(const BasicFraction &lhs, const BasicFraction &rhs) noexcept
+    {
+        return checked_sum<true>(lhs, rhs);
+    }
+
+    /**
+     * @brief Adds or subtracts two fractions by Knuth's algorithm (TAOCP 4.5.1).
+     *
+     * For a/b + c/d with g = gcd(b, d), t = a * (d / g) + c * (b / g) and h = gcd(t, g), the sum is
+     * (t / h) / ((b / g) * (d / h)), already reduced. Instead of a * d + c * b over b * d, the cross products
+     * are only as large as the numerator of the result times g, and the second GCD works on g, not on the
+     * product of the denominators. The result overflows only if its reduced terms do not fit in IntT.
+     *
+     * Integers, equal denominators and denominators that divide one another skip the first GCD.
+     *
+     * @param lhs The left-hand fraction.
+     * @param rhs The right-hand fraction.
+     * @return lhs + rhs, or lhs - rhs if Subtract, in reduced form; or Overflow.
+     */
+    template <typename IntT, typename Precision>
+    template <bool Subtract>
+    constexpr Checked<BasicFraction<IntT, Precision>> BasicFraction<IntT, Precision>::checked_sum(const BasicFraction &lhs, const BasicFraction &rhs) noexcept
+    {
+        BasicFraction result;
+
+        // Integers: the sum of the numerators
+        if ((lhs.denominator | rhs.denominator) == 1)
+        {
+            bool overflow = Subtract ? __builtin_sub_overflow(lhs.numerator, rhs.numerator, &result.numerator)
+                                     : __builtin_add_overflow(lhs.numerator, rhs.numerator, &result.numerator);
+            if (overflow)
+            {
+                return {BasicFraction(), FractionError::Overflow};
+            }
+            return {result};
+        }
+
+        // The GCD of the denominators, which is the smaller one if it divides the larger
+        IntT common = 0;
+        if (lhs.denominator == rhs.denominator)
+        {
+            common = lhs.denominator;
+        }
+        else if (lhs.denominator > rhs.denominator ? lhs.denominator % rhs.denominator == 0 : rhs.denominator % lhs.denominator == 0)
+        {
+            common = std::min(lhs.denominator, rhs.denominator);
+        }
+        else
+        {
+            common = static_cast<IntT>(gcd::compute(static_cast<UInt>(lhs.denominator), static_cast<UInt>(rhs.denominator)));
+        }
+        auto lhs_scale = static_cast<IntT>(lhs.denominator / common);
+        auto rhs_scale = static_cast<IntT>(rhs.denominator / common);
+
+        // t = a * (d / g) + c * (b / g), checked in the wide type
+        Wide left = 0;
+        Wide right = 0;
+        Wide num = 0;
+        bool overflow = !wide_multiply(lhs.numerator, rhs_scale, left) || !wide_multiply(rhs.numerator, lhs_scale, right);
+        overflow = overflow || !(Subtract ? wide_subtract(left, right, num) : wide_add(left, right, num));
+
+        // h = gcd(t, g) divides g, so it is found from t mod g in IntT
+        IntT shared = 1;
+        if (!overflow && common != 1)
+        {
+            using UWide = typename FractionTraits<Wide>::unsigned_type;
+            auto rest = static_cast<UInt>(magnitude(num) % static_cast<UWide>(common));
+            shared = static_cast<IntT>(gcd::compute(rest, static_cast<UInt>(common)));
+            num /= shared;
+        }
+
+        // The denominator is (b / g) * (d / h)
+        overflow = overflow || !fits(num) || __builtin_mul_overflow(lhs_scale, static_cast<IntT>(rhs.denominator / shared), &result.denominator);
+        if (overflow)
+        {
+            return {BasicFraction(), FractionError::Overflow};
+        }
+        result.numerator = static_cast<IntT>(num);
+        result.check_invariant();
+        return {result};
+    }
+
+    /**
+     * @brief Multiplies two fractions without throwing.
+     *
+     * @param lhs The left-hand fraction.
+     * @param rhs The right-hand fraction.
+     * @return The product in reduced form, or Overflow.
+     */
+    template <typename IntT, typename Precision>
+    constexpr Checked<BasicFraction<IntT, Precision>> BasicFraction<IntT, Precision>::checked_mul(const BasicFraction &lhs, const BasicFraction &rhs) noexcept
+    {
+        // Cancel common factors across the operands first; both operands are reduced, so the product of the
+        // cancelled terms is already in simplest form and overflows only if the true result does
+        Wide cross1 = common_factor(lhs.numerator, rhs.denominator);
+        Wide cross2 = common_factor(rhs.numerator, lhs.denominator);
+
+        // The products are the result's terms, so the intrinsics' overflow check is the whole range check
+        BasicFraction result;
+        bool overflow = __builtin_mul_overflow(static_cast<IntT>(lhs.numerator / cross1), static_cast<IntT>(rhs.numerator / cross2), &result.numerator);
+        overflow |= __builtin_mul_overflow(static_cast<IntT>(lhs.denominator / cross2), static_cast<IntT>(rhs.denominator / cross1), &result.denominator);
+        if (overflow)
+        {
+            return {BasicFraction(), FractionError::Overflow};
+        }
+        result.check_invariant();
+        return {result};
+    }
+
+    /**
+     * @brief Divides one fraction by another without throwing.
+     *
+     * @param lhs The dividend.
+     * @param rhs The divisor.
+     * @return The quotient in reduced form, DivideByZero if rhs is zero, or Overflow.
+     */
+    template <typename IntT, typename Precision>
+    constexpr Checked<BasicFraction<IntT, Precision>> BasicFraction<IntT, Precision>::checked_div(const BasicFraction &lhs, const BasicFraction &rhs) noexcept
+    {
+        if (rhs.numerator == 0)
+        {
+            return {BasicFraction(), FractionError::DivideByZero};
+        }
+
+        // Multiply by the reciprocal, cancelling common factors across the operands first
+        Wide cross1 = common_factor(lhs.numerator, rhs.numerator);
+        Wide cross2 = common_factor(rhs.denominator, lhs.denominator);
+        auto divisor_num = static_cast<IntT>(rhs.numerator / cross1);
+        auto divisor_den = static_cast<IntT>(rhs.denominator / cross2);
+
+        // Move the divisor's sign to the numerator, so the denominator stays positive. Only the minimum
+        // overflows, and then so does the denominator of the result.
+        bool overflow = false;
+        if (divisor_num < 0)
+        {
+            overflow = __builtin_sub_overflow(IntT{0}, divisor_num, &divisor_num);
+            divisor_den = static_cast<IntT>(-divisor_den);
+        }
+
+        BasicFraction result;
+        overflow |= __builtin_mul_overflow(static_cast<IntT>(lhs.numerator / cross1), divisor_den, &result.numerator);
+        overflow |= __builtin_mul_overflow(static_cast<IntT>(lhs.denominator / cross2), divisor_num, &result.denominator);
+        if (overflow)
+        {
+            return {BasicFraction(), FractionError::Overflow};
+        }
+        result.check_invariant();
+        return {result};
+    }
+
+    /**
+     * @brief Constructs a fraction without throwing.
+     *
+     * @param numerator The numerator of the fraction.
+     * @param denominator The denominator of the fraction.
+     * @return The fraction in canonical form, ZeroDenominator, or Overflow if the canonical terms do not
+     * fit in IntT, as for 1/INT_MIN and INT_MIN/-1.
+     */
+    template <typename IntT, typename Precision>
+    constexpr Checked<BasicFraction<IntT, Precision>> BasicFraction<IntT, Precision>::checked_make(IntT numerator, IntT denominator) noexcept
+    {
+        if (denominator == 0)
+        {
+            return {BasicFraction(), FractionError::ZeroDenominator};
+        }
+
+        // Reduce the magnitudes, which cannot overflow, then put the sign on the numerator
+        UInt num = magnitude(numerator);
+        UInt denom = magnitude(denominator);
+        UInt common = gcd::compute(num, denom);
+        num = static_cast<UInt>(num / common);
+        denom = static_cast<UInt>(denom / common);
+        bool negative = (numerator < 0) != (denominator < 0);
+
+        // Only a negative numerator can have the magnitude of the minimum
+        if (denom > static_cast<UInt>(Traits::max_value) || (!negative && num > static_cast<UInt>(Traits::max_value)))
+        {
+            return {BasicFraction(), FractionError::Overflow};
+        }
+
+        BasicFraction result;
+        result.numerator = static_cast<IntT>(negative ? static_cast<UInt>(0U - num) : num);
+        result.denominator = static_cast<IntT>(denom);
+        result.check_invariant();
+        return {result};
+    }
+
+    /**
+     * @brief Returns the fraction numerator/denominator in reduced form.
+     *
+     * The arithmetic has already checked the terms, so unlike the constructor this neither checks the
+     * denominator nor logs.
+     *
+     * @param numerator The numerator of the fraction.
+     * @param denominator The denominator of the fraction - must be positive.
+     * @return The reduced fraction.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::reduced(IntT numerator, IntT denominator) noexcept
+    {
+        reduce(numerator, denominator);
+
+        BasicFraction result;
+        result.numerator = numerator;
+        result.denominator = denominator;
+        result.check_invariant();
+        return result;
+    }
+
+    /**
+     * @brief Returns the value of a checked result, or throws the exception its error stands for.
+     *
+     * @param result The checked result.
+     * @return The value of the result.
+     * @throws std::invalid_argument for ZeroDenominator, as the constructor does.
+     * @throws std::runtime_error for DivideByZero and InvalidInput.
+     * @throws std::overflow_error for Overflow.
+     */
+    template <typename IntT, typename Precision>
+    constexpr BasicFraction<IntT, Precision> BasicFraction<IntT, Precision>::unwrap(const Checked<BasicFraction> &result)
+    {
+        switch (result.error)
+        {
+        case FractionError::None:
+            break;
+        case FractionError::ZeroDenominator:
+            throw std::invalid_argument("Denominator can't be zero");
+        case FractionError::DivideByZero:
+            error_zero();
+            break;
+        case FractionError::Overflow:
+            error_overflow();
+            break;
+        case FractionError::InvalidInput:
+            error_invalid();
+            break;
+        }
+        return result.value;
+    }
+
+    /**
+     * @brief Three-way comparison of two fractions, exact at every width.
+     *
+     * The terms are cross-multiplied in the wide type, which is exact for every width up to 64 bits. 128-bit
+     * fractions have no wider type and are compared by their continued fraction expansions instead. The
+     * denominators are positive, so cross-multiplying keeps the order.
+     *
+     * @param lhs The left-hand fraction.
+     * @param rhs The right-hand fraction.
+     * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+     */
+    template <typename IntT, typename Precision>
+    constexpr int BasicFraction<IntT, Precision>::compare(const BasicFraction &lhs, const BasicFraction &rhs) noexcept
+    {
+        // Fast path: with equal denominators only the numerators matter
+        if (lhs.denominator == rhs.denominator)
+        {
+            return (lhs.numerator > rhs.numerator) - (lhs.numerator < rhs.numerator);
+        }
+
+        if constexpr (Traits::widens)
+        {
+            // Cross-multiply - the product of two terms always fits in the wide type
+            Wide left = static_cast<Wide>(lhs.numerator) * static_cast<Wide>(rhs.denominator);
+            Wide right = static_cast<Wide>(rhs.numerator) * static_cast<Wide>(lhs.denominator);
+            return (left > right) - (left < right);
+        }
+        else
+        {
+            // Compare the signs first, then the magnitudes
+            int lhs_sign = (lhs.numerator > 0) - (lhs.numerator < 0);
+            int rhs_sign = (rhs.numerator > 0) - (rhs.numerator < 0);
+            if (lhs_sign != rhs_sign || lhs_sign == 0)
+            {
+                return (lhs_sign > rhs_sign) - (lhs_sign < rhs_sign);
+            }
+
+            int diff = compare_magnitudes(magnitude(lhs.numerator), static_cast<UInt>(lhs.denominator),
+                                          magnitude(rhs.numerator), static_cast<UInt>(rhs.denominator));
+            return lhs_sign > 0 ? diff : -diff;
+        }
+    }
+
+    /**
+     * @brief Compares a/b with c/d for positive terms by their continued fraction expansions.
+     *
+     * @return A negative value if a/b < c/d, zero if they are equal, and a positive value if a/b > c/d.
+     */
+    template <typename IntT, typename Precision>
+    constexpr int BasicFraction<IntT, Precision>::compare_magnitudes(UInt a, UInt b, UInt c, UInt d) noexcept
+    {
+        // Each step compares the integer parts, then the reciprocals of the remainders, which reverses the order
+        bool reversed = false;
+        for (;;)
+        {
+            UInt left = a / b;
+            UInt right = c / d;
+            UInt left_rem = a % b;
+            UInt right_rem = c % d;
+
+            int diff = 0;
+            if (left != right)
+            {
+                diff = left > right ? 1 : -1;
+            }
+            else if (left_rem == 0 || right_rem == 0)
+            {
+                diff = (left_rem != 0) - (right_rem != 0);
+            }
+            else
+            {
+                // a/b = q + r1/b and c/d = q + r2/d, so compare b/r1 with d/r2 instead
+                a = b;
+                b = left_rem;
+                c = d;
+                d = right_rem;
+                reversed = !reversed;
+                continue;
+            }
+            return reversed ? -diff : diff;
+        }
+    }
+
+    /**
+     * @brief Operator overload for equality comparison of two fractions.
+     *
+     * @param other The other fraction to compare to.
+     * @return true if the two fractions have the same value, false otherwise.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::operator==(const BasicFraction &other) const noexcept
+    {
+        return compare(*this, other) == 0;
+    }
+
+    /**
+     * @brief Operator overload for inequality comparison of two fractions.
+     *
+     * @param other The other fraction to compare to.
+     * @return true if the two fractions are not equal, false otherwise.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::operator!=(const BasicFraction &other) const noexcept
+    {
+        return !(*this == other);
+    }
+
+    /**
+     * @brief Operator overload for comparison of two fractions.
+     *
+     * @param other The other fraction to compare to.
+     * @return true if this fraction is greater than the other fraction, false otherwise.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::operator>(const BasicFraction &other) const noexcept
+    {
+        return compare(*this, other) > 0;
+    }
+
+    /**
+     * @brief Operator overload for comparison of two fractions.
+     *
+     * @param other The other fraction to compare to.
+     * @return true if this fraction is less than the other fraction, false otherwise.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::operator<(const BasicFraction &other) const noexcept
+    {
+        return compare(*this, other) < 0;
+    }
+
+    /**
+     * @brief Operator overload for comparison of two fractions.
+     *
+     * @param other The other fraction to compare to.
+     * @return true if this fraction is greater than or equal to the other fraction, false otherwise.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::operator>=(const BasicFraction &other) const noexcept
+    {
+        return compare(*this, other) >= 0;
+    }
+
+    /**
+     * @brief Operator overload for comparison of two fractions.
+     *
+     * @param other The other fraction to compare to.
+     * @return true if this fraction is less than or equal to the other fraction, false otherwise.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::operator<=(const BasicFraction &other) const noexcept
+    {
+        return compare(*this, other) <= 0;
+    }
+
+    /**
+     * @brief Reduces the numerator and denominator of the fraction to their simplest form.
+     *
+     * The GCD is taken over the unsigned magnitudes, so a minimum numerator is handled without overflow, using
+     * the engine selected by FRACTION_GCD_ENGINE. The GCD divides the positive denominator, so it fits in T
+     * and the numerator is divided with its sign.
+     *
+     * @param numerator The numerator of the fraction to reduce.
+     * @param denominator The denominator of the fraction to reduce - must be positive.
+     */
+    template <typename IntT, typename Precision>
+    template <typename T>
+    constexpr void BasicFraction<IntT, Precision>::reduce(T &numerator, T &denominator) noexcept
+    {
+        using U = typename FractionTraits<T>::unsigned_type;
+        assert(denominator > 0);
+
+        auto common = static_cast<T>(gcd::compute(magnitude(numerator), static_cast<U>(denominator)));
+        numerator = static_cast<T>(numerator / common);
+        denominator = static_cast<T>(denominator / common);
+    }
+
+    /**
+     * @brief Returns the absolute value of a signed integer as its unsigned type, without overflow for the minimum.
+     *
+     * @param value The value.
+     * @return |value|.
+     */
+    template <typename IntT, typename Precision>
+    template <typename T>
+    constexpr typename FractionTraits<T>::unsigned_type BasicFraction<IntT, Precision>::magnitude(T value) noexcept
+    {
+        using U = typename FractionTraits<T>::unsigned_type;
+        return value < 0 ? static_cast<U>(0U - static_cast<U>(value)) : static_cast<U>(value);
+    }
+
+    /**
+     * @brief Returns the greatest common divisor of the magnitudes of two terms, in the wide type.
+     *
+     * @param first The first value.
+     * @param second The second value.
+     * @return gcd(|first|, |second|) - at least 1 unless both values are zero.
+     */
+    template <typename IntT, typename Precision>
+    constexpr typename BasicFraction<IntT, Precision>::Wide BasicFraction<IntT, Precision>::common_factor(IntT first, IntT second) noexcept
+    {
+        return static_cast<Wide>(gcd::compute(magnitude(first), magnitude(second)));
+    }
+
+    /**
+     * @brief Multiplies two terms in the wide type.
+     *
+     * @param first The first term.
+     * @param second The second term.
+     * @param product Receives first * second.
+     * @return false if there is no wider type and the product overflows it.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::wide_multiply(IntT first, IntT second, Wide &product) noexcept
+    {
+        if constexpr (Traits::widens)
+        {
+            product = static_cast<Wide>(first) * static_cast<Wide>(second);
+            return true;
+        }
+        else
+        {
+            return !__builtin_mul_overflow(first, second, &product);
+        }
+    }
+
+    /**
+     * @brief Adds two wide values.
+     *
+     * @param first The first value.
+     * @param second The second value.
+     * @param sum Receives first + second.
+     * @return false if the sum overflows the wide type.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::wide_add(Wide first, Wide second, Wide &sum) noexcept
+    {
+        return !__builtin_add_overflow(first, second, &sum);
+    }
+
+    /**
+     * @brief Subtracts two wide values.
+     *
+     * @param first The first value.
+     * @param second The value to subtract.
+     * @param difference Receives first - second.
+     * @return false if the difference overflows the wide type.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::wide_subtract(Wide first, Wide second, Wide &difference) noexcept
+    {
+        return !__builtin_sub_overflow(first, second, &difference);
+    }
+
+    /**
+     * @brief Returns true if a wide value fits in IntT.
+     *
+     * @param value The wide value.
+     * @return true if the value is within the range of IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr bool BasicFraction<IntT, Precision>::fits(Wide value) noexcept
+    {
+        return value <= Traits::max_value && value >= Traits::min_value;
+    }
+
+    /**
+     * @brief Converts a wide value back to a term.
+     *
+     * @param value The wide value.
+     * @return The value as IntT.
+     * @throws std::overflow_error if the value does not fit in IntT.
+     */
+    template <typename IntT, typename Precision>
+    constexpr IntT BasicFraction<IntT, Precision>::narrow(Wide value)
+    {
+        if (!fits(value))
+        {
+            error_overflow();
+        }
+        return static_cast<IntT>(value);
+    }
+
+    /**
+     * @brief Computes numerator / denominator * Precision::scale rounded half away from zero, exactly.
+     *
+     * @param numerator The numerator of the fraction.
+     * @param denominator The denominator of the fraction - must be positive.
+     * @return The scaled and rounded value.
+     */
+    template <typename IntT, typename Precision>
+    constexpr typename BasicFraction<IntT, Precision>::Wide BasicFraction<IntT, Precision>::scaled_round(Wide numerator, Wide denominator) noexcept
+    {
+        // Rounding half away from zero is (2 * |x| + d) / (2 * d) on the magnitude
+        Wide scaled = numerator * static_cast<Wide>(Precision::scale);
+        Wide magnitude = (2 * (scaled < 0 ? -scaled : scaled) + denominator) / (2 * denominator);
+        return scaled < 0 ? -magnitude : magnitude;
+    }
+
+    // The member functions that are not inline are compiled once in Fraction.cpp for every supported width and
+    // precision
+    extern template class BasicFraction<std::int8_t>;
+    extern template class BasicFraction<std::int16_t>;
+    extern template class BasicFraction<int>;
+    extern template class BasicFraction<std::int64_t>;
+    extern template class BasicFraction<__int128>;
+    extern template class BasicFraction<int, DecimalPrecision<2>>;
+    extern template class BasicFraction<int, DecimalPrecision<6>>;
+
+    /**
+     * @brief True if a fraction is its two terms and nothing else: trivially copyable and standard layout, so
+     * containers copy and move fractions with memcpy and a fraction is passed by value in registers.
+     */
+    template <typename IntT, typename Precision = DefaultPrecision>
+    constexpr bool is_plain_fraction = std::is_trivially_copyable_v<BasicFraction<IntT, Precision>> &&
+                                       std::is_standard_layout_v<BasicFraction<IntT, Precision>> &&
+                                       sizeof(BasicFraction<IntT, Precision>) == 2 * sizeof(IntT);
+
+    static_assert(is_plain_fraction<int> && sizeof(Fraction) == 8, "Fraction must stay two ints, copyable with memcpy");
+    static_assert(is_plain_fraction<std::int8_t> && is_plain_fraction<std::int16_t> && is_plain_fraction<std::int64_t> &&
+                      is_plain_fraction<__int128>,
+                  "Fractions of every width must stay two terms, copyable with memcpy");
+    static_assert(is_plain_fraction<int, DecimalPrecision<2>> && is_plain_fraction<int, DecimalPrecision<6>>,
+                  "The precision must not add state to a fraction");
 };
 
 #endif
@@ -0,0 +1,262 @@
+/**
+ * @file FractionAccumulator.hpp
+ * @brief A lazily reduced fraction for long accumulation chains.
+ *
+ * Every Fraction operator reduces its result and checks it against the int range. A FractionAccumulator
+ * instead keeps an unreduced numerator and denominator in 128-bit integers and only reduces them when they
+ * would no longer fit in 62 bits. Summing millions of fractions therefore costs a multiply-add per term and
+ * an occasional GCD, instead of a GCD per term. Observers (getNumerator, getDenominator, to_fraction,
+ * to_double and operator<<) reduce a copy of the terms, so a const accumulator may be read from several
+ * threads at once.
+ */
+
+#ifndef FRACTION_ACCUMULATOR_HPP
+#define FRACTION_ACCUMULATOR_HPP
+
+#include "Fraction.hpp"
+
+namespace ariel
+{
+    class FractionAccumulator
+    {
+    private:
+        // Terms at rest are kept below 2^62, so a term times an int operand can never overflow 128 bits
+        static constexpr unsigned __int128 LIMIT = static_cast<unsigned __int128>(1) << 62U;
+
+        // The value is numerator / denominator, not necessarily reduced; the denominator is always positive.
+        // Observers reduce a copy and never write the terms, so concurrent reads are safe.
+        __int128 numerator = 0;
+        __int128 denominator = 1;
+
+        struct Terms
+        {
+            __int128 numerator;
+            __int128 denominator;
+        };
+
+        static constexpr unsigned __int128 magnitude(__int128 value) noexcept
+        {
+            return value < 0 ? 0U - static_cast<unsigned __int128>(value) : static_cast<unsigned __int128>(value);
+        }
+
+        // num / denom divided by their GCD, where denom is positive
+        static constexpr Terms reduced(__int128 num, __int128 denom) noexcept
+        {
+            auto common = static_cast<__int128>(gcd::compute(magnitude(num), static_cast<unsigned __int128>(denom)));
+            return {num / common, denom / common};
+        }
+
+        // The terms divided by their GCD
+        constexpr Terms reduced() const noexcept
+        {
+            return reduced(numerator, denominator);
+        }
+
+        // Adds num / denom, where denom is positive
+        constexpr void add(long long int num, long long int denom)
+        {
+            auto current = static_cast<long long int>(denominator);
+            if (current % denom == 0)
+            {
+                // The current denominator is already a multiple of denom - scale the numerator only
+                settle(numerator + static_cast<__int128>(num) * (current / denom), denominator);
+            }
+            else
+            {
+                settle(numerator * denom + static_cast<__int128>(num) * denominator, denominator * denom);
+            }
+        }
+
+        // Stores num / denom, reduced if a term has grown past LIMIT. Fails, leaving the value unchanged, if
+        // even the reduced terms are too large.
+        constexpr void settle(__int128 num, __int128 denom)
+        {
+            if (magnitude(num) >= LIMIT || magnitude(denom) >= LIMIT)
+            {
+                Terms terms = reduced(num, denom);
+                if (magnitude(terms.numerator) >= LIMIT || magnitude(terms.denominator) >= LIMIT)
+                {
+                    Fraction::error_overflow();
+                }
+                num = terms.numerator;
+                denom = terms.denominator;
+            }
+            numerator = num;
+            denominator = denom;
+        }
+
+    public:
+        /**
+         * @brief Creates an accumulator holding zero.
+         */
+        constexpr FractionAccumulator() noexcept = default;
+
+        /**
+         * @brief Creates an accumulator holding the value of a fraction.
+         */
+        constexpr FractionAccumulator(const Fraction &fraction)
+        {
+            // Fraction denominators are always positive
+            numerator = fraction.getNumerator();
+            denominator = fraction.getDenominator();
+        }
+
+        /**
+         * @brief Adds a fraction. When the current denominator is a multiple of the operand's, no new factor
+         * is introduced into the denominator.
+         *
+         * @throws std::overflow_error if the reduced sum no longer fits in 62 bits.
+         */
+        constexpr FractionAccumulator &operator+=(const Fraction &other)
+        {
+            add(static_cast<long long int>(other.getNumerator()), other.getDenominator());
+            return *this;
+        }
+
+        /**
+         * @brief Subtracts a fraction.
+         *
+         * @throws std::overflow_error if the reduced difference no longer fits in 62 bits.
+         */
+        constexpr FractionAccumulator &operator-=(const Fraction &other)
+        {
+            add(-static_cast<long long int>(other.getNumerator()), other.getDenominator());
+            return *this;
+        }
+
+        /**
+         * @brief Multiplies by a fraction.
+         *
+         * @throws std::overflow_error if the reduced product no longer fits in 62 bits.
+         */
+        constexpr FractionAccumulator &operator*=(const Fraction &other)
+        {
+            long long int num = other.getNumerator();
+            long long int denom = other.getDenominator();
+
+            settle(numerator * num, denominator * denom);
+            return *this;
+        }
+
+        /**
+         * @brief Divides by a fraction.
+         *
+         * @throws std::runtime_error if other is zero.
+         * @throws std::overflow_error if the reduced quotient no longer fits in 62 bits.
+         */
+        constexpr FractionAccumulator &operator/=(const Fraction &other)
+        {
+            long long int num = other.getNumerator();
+            long long int denom = other.getDenominator();
+            if (num == 0)
+            {
+                Fraction::error_zero();
+            }
+
+            // Multiply by the reciprocal, keeping the denominator positive
+            if (num < 0)
+            {
+                num = -num;
+                denom = -denom;
+            }
+            settle(numerator * denom, denominator * num);
+            return *this;
+        }
+
+        /**
+         * @brief The numerator of the reduced value.
+         */
+        constexpr long long int getNumerator() const noexcept
+        {
+            return static_cast<long long int>(reduced().numerator);
+        }
+
+        /**
+         * @brief The denominator of the reduced value - always positive.
+         */
+        constexpr long long int getDenominator() const noexcept
+        {
+            return static_cast<long long int>(reduced().denominator);
+        }
+
+        /**
+         * @brief Converts the accumulated value to a Fraction.
+         *
+         * @throws std::overflow_error if the reduced value does not fit in an int fraction.
+         */
+        constexpr Fraction to_fraction() const
+        {
+            Terms terms = reduced();
+            if (terms.numerator > std::numeric_limits<int>::max() || terms.numerator < std::numeric_limits<int>::min() ||
+                terms.denominator > std::numeric_limits<int>::max())
+            {
+                Fraction::error_overflow();
+            }
+            return Fraction(static_cast<int>(terms.numerator), static_cast<int>(terms.denominator));
+        }
+
+        /**
+         * @brief Converts the accumulated value to a double.
+         */
+        constexpr double to_double() const noexcept
+        {
+            Terms terms = reduced();
+            return static_cast<double>(terms.numerator) / static_cast<double>(terms.denominator);
+        }
+
+        /**
+         * @brief Three-way comparison by exact cross-multiplication of the terms.
+         *
+         * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+         */
+        static constexpr int compare(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            // Terms are below 2^62, reduced or not, so the products fit in 124 bits
+            __int128 left = lhs.numerator * rhs.denominator;
+            __int128 right = rhs.numerator * lhs.denominator;
+            return (left > right) - (left < right);
+        }
+
+        friend constexpr bool operator==(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            return compare(lhs, rhs) == 0;
+        }
+
+        friend constexpr bool operator!=(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            return compare(lhs, rhs) != 0;
+        }
+
+        friend constexpr bool operator<(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            return compare(lhs, rhs) < 0;
+        }
+
+        friend constexpr bool operator>(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            return compare(lhs, rhs) > 0;
+        }
+
+        friend constexpr bool operator<=(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            return compare(lhs, rhs) <= 0;
+        }
+
+        friend constexpr bool operator>=(const FractionAccumulator &lhs, const FractionAccumulator &rhs) noexcept
+        {
+            return compare(lhs, rhs) >= 0;
+        }
+
+        /**
+         * @brief Prints the reduced value in the format "numerator/denominator".
+         */
+        friend std::ostream &operator<<(std::ostream &ostrm, const FractionAccumulator &accumulator)
+        {
+            Terms terms = accumulator.reduced();
+            ostrm << static_cast<long long int>(terms.numerator) << "/" << static_cast<long long int>(terms.denominator);
+            return ostrm;
+        }
+    };
+}
+
+#endif
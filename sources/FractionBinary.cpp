@@ -0,0 +1,282 @@
+/**
+ * @file FractionBinary.cpp
+ * @brief Implementation file for the binary fraction format.
+ */
+
+#include "FractionBinary.hpp"
+#include "FractionFile.hpp"
+
+#include <cerrno>       // For errno
+#include <fstream>      // For file output
+#include <iterator>     // For std::istreambuf_iterator
+#include <system_error> // For std::system_error
+
+using namespace ariel;
+using binary::Encoding;
+
+namespace
+{
+    const char MAGIC[4] = {'F', 'R', 'A', 'C'};
+
+    [[noreturn]] void error_format(const char *reason)
+    {
+        throw std::invalid_argument(std::string("Invalid binary fractions: ") + reason);
+    }
+
+    void store_le(std::vector<char> &out, std::uint64_t value, std::size_t bytes)
+    {
+        for (std::size_t i = 0; i < bytes; ++i)
+        {
+            out.push_back(static_cast<char>(value & 0xFFU));
+            value >>= 8U;
+        }
+    }
+
+    std::uint64_t load_le64(const char *bytes) noexcept
+    {
+        std::uint64_t value = 0;
+        for (std::size_t i = 8; i-- > 0;)
+        {
+            value = (value << 8U) | static_cast<unsigned char>(bytes[i]);
+        }
+        return value;
+    }
+
+    void store_varint(std::vector<char> &out, std::uint32_t value)
+    {
+        while (value >= 0x80U)
+        {
+            out.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+            value >>= 7U;
+        }
+        out.push_back(static_cast<char>(value));
+    }
+
+    // Reads a varint of at most 32 bits; fails on truncated or overlong input
+    bool load_varint(const char *&first, const char *last, std::uint32_t &value) noexcept
+    {
+        value = 0;
+        for (unsigned int shift = 0; shift < 35 && first != last; shift += 7)
+        {
+            auto byte = static_cast<unsigned char>(*first++);
+            std::uint64_t wide = value | static_cast<std::uint64_t>(byte & 0x7FU) << shift;
+            if (wide > 0xFFFFFFFFU)
+            {
+                return false;
+            }
+            value = static_cast<std::uint32_t>(wide);
+            if ((byte & 0x80U) == 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Zigzag maps small magnitudes of either sign to small unsigned values: 0, -1, 1, -2 -> 0, 1, 2, 3
+    std::uint32_t zigzag(std::int32_t value) noexcept
+    {
+        return (static_cast<std::uint32_t>(value) << 1U) ^ static_cast<std::uint32_t>(value >> 31);
+    }
+
+    std::int32_t unzigzag(std::uint32_t value) noexcept
+    {
+        return static_cast<std::int32_t>((value >> 1U) ^ (0U - (value & 1U)));
+    }
+
+    // Checks the header and returns the encoding and the number of fractions
+    Encoding read_header(const char *data, std::size_t size, std::uint64_t &count)
+    {
+        if (size < binary::HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0)
+        {
+            error_format("missing header");
+        }
+        if (static_cast<std::uint8_t>(data[4]) != binary::VERSION)
+        {
+            error_format("unsupported version");
+        }
+        auto encoding = static_cast<Encoding>(data[5]);
+        if (encoding != Encoding::Fixed && encoding != Encoding::Varint)
+        {
+            error_format("unknown encoding");
+        }
+        count = load_le64(data + 8);
+        return encoding;
+    }
+}
+
+/**
+ * @brief Encodes fractions, header included.
+ *
+ * @param fractions The fractions to encode.
+ * @param encoding The encoding of the fractions after the header.
+ * @return The encoded bytes.
+ */
+std::vector<char> binary::encode(const std::vector<Fraction> &fractions, Encoding encoding)
+{
+    std::vector<char> out;
+    out.reserve(HEADER_SIZE + fractions.size() * (encoding == Encoding::Fixed ? FIXED_SIZE : 4));
+    for (char character : MAGIC)
+    {
+        out.push_back(character);
+    }
+    out.push_back(static_cast<char>(VERSION));
+    out.push_back(static_cast<char>(encoding));
+    store_le(out, 0, 2);
+    store_le(out, fractions.size(), 8);
+
+    for (const Fraction &fraction : fractions)
+    {
+        // Fractions are canonical, so the sign is already on the numerator
+        std::int32_t num = fraction.getNumerator();
+        std::int32_t den = fraction.getDenominator();
+        if (encoding == Encoding::Fixed)
+        {
+            store_le(out, static_cast<std::uint32_t>(num), 4);
+            store_le(out, static_cast<std::uint32_t>(den), 4);
+        }
+        else
+        {
+            store_varint(out, zigzag(num));
+            store_varint(out, static_cast<std::uint32_t>(den));
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Decodes a buffer written by encode, in either encoding.
+ *
+ * @param data The encoded bytes.
+ * @param size The number of bytes.
+ * @return The fractions.
+ * @throws std::invalid_argument if the buffer is not a valid binary fraction file of this version.
+ */
+std::vector<Fraction> binary::decode(const char *data, std::size_t size)
+{
+    std::uint64_t count = 0;
+    Encoding encoding = read_header(data, size, count);
+    if (encoding == Encoding::Fixed)
+    {
+        FractionView view(data, size);
+        std::vector<Fraction> fractions;
+        fractions.reserve(view.size());
+        for (std::size_t i = 0; i < view.size(); ++i)
+        {
+            if (view.denominator(i) <= 0)
+            {
+                error_format("denominator not positive");
+            }
+            fractions.push_back(view[i]);
+        }
+        return fractions;
+    }
+
+    // Every varint takes at least a byte, which bounds a count that is honest
+    const char *first = data + HEADER_SIZE;
+    const char *last = data + size;
+    if (count > static_cast<std::uint64_t>(last - first) / 2)
+    {
+        error_format("truncated");
+    }
+    std::vector<Fraction> fractions;
+    fractions.reserve(static_cast<std::size_t>(count));
+    for (std::uint64_t i = 0; i < count; ++i)
+    {
+        std::uint32_t num = 0;
+        std::uint32_t den = 0;
+        if (!load_varint(first, last, num) || !load_varint(first, last, den))
+        {
+            error_format("truncated");
+        }
+        if (den == 0 || den > static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+        {
+            error_format("denominator not positive");
+        }
+        fractions.push_back(Fraction(unzigzag(num), static_cast<int>(den)));
+    }
+    if (first != last)
+    {
+        error_format("trailing data");
+    }
+    return fractions;
+}
+
+/**
+ * @brief Writes fractions to a stream.
+ *
+ * @param ostrm The stream to write to.
+ * @param fractions The fractions to write.
+ * @param encoding The encoding of the fractions after the header.
+ */
+void binary::write(std::ostream &ostrm, const std::vector<Fraction> &fractions, Encoding encoding)
+{
+    std::vector<char> bytes = encode(fractions, encoding);
+    ostrm.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+/**
+ * @brief Reads fractions written by write from the rest of a stream.
+ *
+ * @param istrm The stream to read from.
+ * @return The fractions.
+ * @throws std::invalid_argument if the data is not a valid binary fraction file of this version.
+ */
+std::vector<Fraction> binary::read(std::istream &istrm)
+{
+    std::vector<char> bytes((std::istreambuf_iterator<char>(istrm)), std::istreambuf_iterator<char>());
+    return decode(bytes.data(), bytes.size());
+}
+
+/**
+ * @brief Writes fractions to a file.
+ *
+ * @param path The file to write.
+ * @param fractions The fractions to write.
+ * @param encoding The encoding of the fractions after the header.
+ * @throws std::system_error if the file cannot be written.
+ */
+void binary::save(const std::string &path, const std::vector<Fraction> &fractions, Encoding encoding)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    write(file, fractions, encoding);
+    file.close();
+    if (!file)
+    {
+        throw std::system_error(errno, std::generic_category(), "Can't write " + path);
+    }
+}
+
+/**
+ * @brief Reads a file written by save, through a memory mapping.
+ *
+ * @param path The file to read.
+ * @return The fractions.
+ */
+std::vector<Fraction> binary::load(const std::string &path)
+{
+    MappedFile file(path);
+    return decode(file.data(), file.size());
+}
+
+/**
+ * @brief Checks the header and the size of the buffer.
+ *
+ * @param data The start of the buffer, at the header.
+ * @param size The size of the buffer.
+ * @throws std::invalid_argument if the buffer is not a valid Fixed-encoded file of this version.
+ */
+binary::FractionView::FractionView(const char *data, std::size_t size)
+{
+    std::uint64_t stored = 0;
+    if (read_header(data, size, stored) != Encoding::Fixed)
+    {
+        error_format("only the Fixed encoding can be viewed in place");
+    }
+    if (stored != (size - HEADER_SIZE) / FIXED_SIZE || (size - HEADER_SIZE) % FIXED_SIZE != 0)
+    {
+        error_format("size does not match the count");
+    }
+    records = data + HEADER_SIZE;
+    count = static_cast<std::size_t>(stored);
+}
@@ -0,0 +1,140 @@
+/**
+ * @file FractionBinary.hpp
+ * @brief A compact, versioned binary format for arrays of fractions.
+ *
+ * A binary fraction file is a 16-byte header followed by the fractions:
+ *
+ *   offset  size  field
+ *   0       4     magic "FRAC"
+ *   4       1     format version (VERSION)
+ *   5       1     encoding (Encoding)
+ *   6       2     reserved, zero
+ *   8       8     number of fractions, little-endian
+ *
+ * Every fraction is stored reduced, with a positive denominator. The Fixed encoding stores each as two
+ * little-endian 32-bit integers, 8 bytes per fraction, so element i is at a known offset and a mapped file
+ * can be read in place through a FractionView. The Varint encoding stores the zigzag-encoded numerator and
+ * the denominator as LEB128 varints - 2 to 4 bytes for typical values - and must be decoded in order.
+ */
+
+#ifndef FRACTION_BINARY_HPP
+#define FRACTION_BINARY_HPP
+
+#include "Fraction.hpp"
+
+#include <bit>     // For std::endian
+#include <cstdint> // For the fixed-width integer types
+#include <cstring> // For std::memcpy
+#include <string>  // For file names
+#include <vector>  // For encoded buffers and decoded fractions
+
+namespace ariel
+{
+    namespace binary
+    {
+        // The version written into new files; readers reject any other
+        constexpr std::uint8_t VERSION = 1;
+
+        constexpr std::size_t HEADER_SIZE = 16;
+
+        // The size of a fraction in the Fixed encoding
+        constexpr std::size_t FIXED_SIZE = 8;
+
+        /**
+         * @brief How the fractions after the header are stored.
+         */
+        enum class Encoding : std::uint8_t
+        {
+            Fixed = 0, // Two little-endian int32 per fraction
+            Varint = 1 // Zigzag numerator and denominator as LEB128 varints
+        };
+
+        /**
+         * @brief Reads a little-endian 32-bit integer from unaligned memory.
+         */
+        inline std::int32_t load_le32(const char *bytes) noexcept
+        {
+            std::uint32_t value = 0;
+            std::memcpy(&value, bytes, sizeof(value));
+            if constexpr (std::endian::native == std::endian::big)
+            {
+                value = __builtin_bswap32(value);
+            }
+            return static_cast<std::int32_t>(value);
+        }
+
+        /**
+         * @brief Encodes fractions, header included.
+         */
+        std::vector<char> encode(const std::vector<Fraction> &fractions, Encoding encoding = Encoding::Fixed);
+
+        /**
+         * @brief Decodes a buffer written by encode, in either encoding.
+         *
+         * @throws std::invalid_argument if the buffer is not a valid binary fraction file of this version.
+         */
+        std::vector<Fraction> decode(const char *data, std::size_t size);
+
+        /**
+         * @brief Writes fractions to a stream.
+         */
+        void write(std::ostream &ostrm, const std::vector<Fraction> &fractions, Encoding encoding = Encoding::Fixed);
+
+        /**
+         * @brief Reads fractions written by write from the rest of a stream.
+         *
+         * @throws std::invalid_argument if the data is not a valid binary fraction file of this version.
+         */
+        std::vector<Fraction> read(std::istream &istrm);
+
+        /**
+         * @brief Writes fractions to a file.
+         *
+         * @throws std::system_error if the file cannot be written.
+         */
+        void save(const std::string &path, const std::vector<Fraction> &fractions, Encoding encoding = Encoding::Fixed);
+
+        /**
+         * @brief Reads a file written by save, through a memory mapping.
+         *
+         * @throws std::system_error if the file cannot be opened or mapped.
+         * @throws std::invalid_argument if the file is not a valid binary fraction file of this version.
+         */
+        std::vector<Fraction> load(const std::string &path);
+
+        /**
+         * @brief A read-only view of Fixed-encoded fractions in place, e.g. in a MappedFile. The view does not
+         * own the buffer, which must outlive it.
+         */
+        class FractionView
+        {
+        private:
+            const char *records = nullptr; // The first fraction, past the header
+            std::size_t count = 0;
+
+        public:
+            /**
+             * @brief Checks the header and the size of the buffer.
+             *
+             * @throws std::invalid_argument if the buffer is not a valid Fixed-encoded file of this version.
+             */
+            FractionView(const char *data, std::size_t size);
+
+            std::size_t size() const noexcept { return count; }
+            bool empty() const noexcept { return count == 0; }
+
+            // The stored terms of element index, without constructing a Fraction
+            std::int32_t numerator(std::size_t index) const noexcept { return load_le32(records + index * FIXED_SIZE); }
+            std::int32_t denominator(std::size_t index) const noexcept { return load_le32(records + index * FIXED_SIZE + 4); }
+
+            /**
+             * @brief Returns element index as a Fraction.
+             *
+             * @throws std::invalid_argument if the stored denominator is zero.
+             */
+            Fraction operator[](std::size_t index) const { return Fraction(numerator(index), denominator(index)); }
+        };
+    }
+}
+
+#endif
@@ -0,0 +1,249 @@
+/**
+ * @file FractionFile.cpp
+ * @brief Implementation file for the memory-mapped fraction file loader.
+ */
+
+#include "FractionFile.hpp"
+
+#include <algorithm>    // For std::find and std::count
+#include <cerrno>       // For errno
+#include <exception>    // For std::exception_ptr
+#include <system_error> // For std::system_error
+#include <thread>       // For the parsing threads
+
+#include <fcntl.h>    // For open
+#include <sys/mman.h> // For mmap
+#include <sys/stat.h> // For fstat
+#include <unistd.h>   // For close
+
+using namespace ariel;
+
+namespace
+{
+    // Chunks smaller than this are not worth a thread of their own
+    constexpr std::size_t MIN_CHUNK = 1 << 16;
+
+    [[noreturn]] void error_system(const std::string &what)
+    {
+        throw std::system_error(errno, std::generic_category(), what);
+    }
+
+    // The fractions of one chunk, and the first error in it. An exception thrown while parsing, such as
+    // std::bad_alloc, is kept to be rethrown on the calling thread.
+    struct Chunk
+    {
+        const char *first;
+        const char *last;
+        std::vector<Fraction> fractions;
+        ParseResult result{nullptr, ParseError::None};
+        std::exception_ptr failure;
+    };
+
+    const char *describe(ParseError error) noexcept
+    {
+        switch (error)
+        {
+        case ParseError::ZeroDenominator:
+            return "zero denominator";
+        case ParseError::OutOfRange:
+            return "out of range";
+        case ParseError::TrailingInput:
+            return "characters after the fraction";
+        default:
+            return "invalid fraction";
+        }
+    }
+}
+
+/**
+ * @brief Maps the file at path.
+ *
+ * @param path The file to map.
+ * @throws std::system_error if the file cannot be opened or mapped.
+ */
+MappedFile::MappedFile(const std::string &path)
+{
+    int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (descriptor < 0)
+    {
+        error_system("Can't open " + path);
+    }
+
+    struct stat status
+    {
+    };
+    if (::fstat(descriptor, &status) != 0)
+    {
+        int saved = errno;
+        ::close(descriptor);
+        errno = saved;
+        error_system("Can't read the size of " + path);
+    }
+
+    // An empty file cannot be mapped, and needs no mapping
+    length = static_cast<std::size_t>(status.st_size);
+    if (length != 0)
+    {
+        void *address = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (address == MAP_FAILED)
+        {
+            int saved = errno;
+            ::close(descriptor);
+            errno = saved;
+            error_system("Can't map " + path);
+        }
+        ::madvise(address, length, MADV_SEQUENTIAL);
+        mapping = static_cast<const char *>(address);
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    ::close(descriptor);
+}
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : mapping(other.mapping), length(other.length)
+{
+    other.mapping = nullptr;
+    other.length = 0;
+}
+
+MappedFile &MappedFile::operator=(MappedFile &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (mapping != nullptr)
+        {
+            ::munmap(const_cast<char *>(mapping), length);
+        }
+        mapping = other.mapping;
+        length = other.length;
+        other.mapping = nullptr;
+        other.length = 0;
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile()
+{
+    if (mapping != nullptr)
+    {
+        ::munmap(const_cast<char *>(mapping), length);
+    }
+}
+
+/**
+ * @brief Parses one fraction per line from [first, last), splitting the lines between threads.
+ *
+ * @param first The start of the text.
+ * @param last The end of the text.
+ * @param threads The number of threads, or 0 for one per hardware thread. Small inputs use fewer.
+ * @return The fractions in the order of the text.
+ * @throws std::invalid_argument naming the line of the first fraction that does not parse.
+ */
+std::vector<Fraction> ariel::parse_fractions_parallel(const char *first, const char *last, unsigned int threads)
+{
+    std::size_t size = static_cast<std::size_t>(last - first);
+    std::size_t count = threads != 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+    count = std::max<std::size_t>(1, std::min(count, size / MIN_CHUNK));
+
+    // Cut the text into equal chunks, moving every cut forward to the start of the next line
+    std::vector<Chunk> chunks(count);
+    const char *start = first;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const char *cut = i + 1 == count ? last : std::max(start, first + size / count * (i + 1));
+        cut = std::find(cut, last, '\n');
+        if (cut != last)
+        {
+            ++cut;
+        }
+        chunks[i].first = start;
+        chunks[i].last = cut;
+        start = cut;
+    }
+
+    // Parse the chunks concurrently; the first chunk runs on this thread. Fractions take at least
+    // four characters ("1/2\n"), which bounds the reservation. An exception must not leave a thread.
+    auto parse = [](Chunk &chunk) noexcept
+    {
+        try
+        {
+            chunk.fractions.reserve(static_cast<std::size_t>(chunk.last - chunk.first) / 8);
+            chunk.result = parse_fraction_lines(chunk.first, chunk.last, std::back_inserter(chunk.fractions));
+        }
+        catch (...)
+        {
+            chunk.failure = std::current_exception();
+        }
+    };
+    {
+        // A jthread joins when it is destroyed, so the workers already started are joined even if starting
+        // the next one throws
+        std::vector<std::jthread> workers;
+        workers.reserve(count - 1);
+        for (std::size_t i = 1; i < count; ++i)
+        {
+            workers.emplace_back(parse, std::ref(chunks[i]));
+        }
+        parse(chunks[0]);
+    }
+
+    // Report the first failure or error in text order, then join the chunks
+    std::size_t total = 0;
+    for (const Chunk &chunk : chunks)
+    {
+        if (chunk.failure)
+        {
+            std::rethrow_exception(chunk.failure);
+        }
+        if (chunk.result.error != ParseError::None)
+        {
+            auto line = std::count(first, chunk.result.ptr, '\n') + 1;
+            throw std::invalid_argument("Invalid input on line " + std::to_string(line) + ": " + describe(chunk.result.error));
+        }
+        total += chunk.fractions.size();
+    }
+    if (count == 1)
+    {
+        return std::move(chunks[0].fractions);
+    }
+    std::vector<Fraction> fractions;
+    fractions.reserve(total);
+    for (const Chunk &chunk : chunks)
+    {
+        fractions.insert(fractions.end(), chunk.fractions.begin(), chunk.fractions.end());
+    }
+    return fractions;
+}
+
+/**
+ * @brief Loads a fraction file into a vector of Fractions.
+ *
+ * @param path The file to load.
+ * @param threads The number of threads, or 0 for one per hardware thread.
+ * @return The fractions in the order of the file.
+ */
+std::vector<Fraction> ariel::load_fractions(const std::string &path, unsigned int threads)
+{
+    MappedFile file(path);
+    return parse_fractions_parallel(file.begin(), file.end(), threads);
+}
+
+/**
+ * @brief Loads a fraction file into a structure-of-arrays FractionVector.
+ *
+ * @param path The file to load.
+ * @param threads The number of threads, or 0 for one per hardware thread.
+ * @return The fractions in the order of the file.
+ */
+FractionVector ariel::load_fraction_vector(const std::string &path, unsigned int threads)
+{
+    std::vector<Fraction> fractions = load_fractions(path, threads);
+    FractionVector vector;
+    vector.reserve(fractions.size());
+    for (const Fraction &fraction : fractions)
+    {
+        vector.push_back(fraction);
+    }
+    return vector;
+}
@@ -0,0 +1,85 @@
+/**
+ * @file FractionFile.hpp
+ * @brief Bulk loading of fraction text files through a memory mapping and parallel parsing.
+ *
+ * A fraction file holds one fraction per line, in the "numerator/denominator" form operator<< writes (the
+ * "numerator denominator" form is accepted too). The file is mapped into memory instead of read through a
+ * stream, split into one chunk per thread at line boundaries, and every chunk is parsed with
+ * parse_fraction_lines concurrently. A fraction never spans lines, so the result does not depend on where
+ * the chunks are cut. The chunks are then joined in order into one contiguous result.
+ */
+
+#ifndef FRACTION_FILE_HPP
+#define FRACTION_FILE_HPP
+
+#include "FractionParser.hpp"
+#include "FractionVector.hpp"
+
+#include <cstddef> // For std::size_t
+#include <string>  // For file names
+#include <vector>  // For the results
+
+namespace ariel
+{
+    /**
+     * @brief A read-only memory mapping of a whole file.
+     */
+    class MappedFile
+    {
+    private:
+        const char *mapping = nullptr;
+        std::size_t length = 0;
+
+    public:
+        /**
+         * @brief Maps the file at path.
+         *
+         * @throws std::system_error if the file cannot be opened or mapped.
+         */
+        explicit MappedFile(const std::string &path);
+
+        MappedFile(const MappedFile &other) = delete;
+        MappedFile(MappedFile &&other) noexcept;
+        MappedFile &operator=(const MappedFile &other) = delete;
+        MappedFile &operator=(MappedFile &&other) noexcept;
+        ~MappedFile();
+
+        const char *data() const noexcept { return mapping; }
+        std::size_t size() const noexcept { return length; }
+        const char *begin() const noexcept { return mapping; }
+        const char *end() const noexcept { return mapping + length; }
+    };
+
+    /**
+     * @brief Parses one fraction per line from [first, last), splitting the lines between threads.
+     *
+     * @param first The start of the text.
+     * @param last The end of the text.
+     * @param threads The number of threads, or 0 for one per hardware thread. Small inputs use fewer.
+     * @return The fractions in the order of the text.
+     * @throws std::invalid_argument naming the line of the first fraction that does not parse.
+     */
+    std::vector<Fraction> parse_fractions_parallel(const char *first, const char *last, unsigned int threads = 0);
+
+    /**
+     * @brief Loads a fraction file into a vector of Fractions.
+     *
+     * @param path The file to load.
+     * @param threads The number of threads, or 0 for one per hardware thread.
+     * @throws std::system_error if the file cannot be opened or mapped.
+     * @throws std::invalid_argument naming the line of the first fraction that does not parse.
+     */
+    std::vector<Fraction> load_fractions(const std::string &path, unsigned int threads = 0);
+
+    /**
+     * @brief Loads a fraction file into a structure-of-arrays FractionVector.
+     *
+     * @param path The file to load.
+     * @param threads The number of threads, or 0 for one per hardware thread.
+     * @throws std::system_error if the file cannot be opened or mapped.
+     * @throws std::invalid_argument naming the line of the first fraction that does not parse.
+     */
+    FractionVector load_fraction_vector(const std::string &path, unsigned int threads = 0);
+}
+
+#endif
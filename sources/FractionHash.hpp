@@ -0,0 +1,341 @@
+/**
+ * @file FractionHash.hpp
+ * @brief Hashing of fractions, and FractionHashMap, an open-addressing map keyed by fractions.
+ *
+ * A fraction is hashed by its terms, which are canonical: reduced, with the sign on the numerator, so
+ * Fraction(3, -4) and Fraction(-3, 4) hash alike. For int terms the canonical terms are packed
+ * into one 64-bit word, which is then mixed, so distinct fractions only collide in the bucket index.
+ *
+ * operator== compares values exactly, so fractions that are equal have the same canonical terms and the same
+ * hash, and std::unordered_map<Fraction, T> and std::unordered_set<Fraction> work as they are.
+ */
+
+#ifndef FRACTION_HASH_HPP
+#define FRACTION_HASH_HPP
+
+#include "Fraction.hpp"
+
+#include <cstddef>    // For std::size_t
+#include <cstdint>    // For std::uint64_t
+#include <functional> // For std::hash
+#include <utility>    // For std::pair
+#include <vector>     // For the slots
+
+namespace ariel
+{
+    namespace hashing
+    {
+        /**
+         * @brief The terms of a fraction with the sign on the numerator, as unsigned bit patterns.
+         */
+        template <typename IntT>
+        struct CanonicalTerms
+        {
+            typename FractionTraits<IntT>::unsigned_type numerator;
+            typename FractionTraits<IntT>::unsigned_type denominator;
+
+            constexpr bool operator==(const CanonicalTerms &other) const noexcept = default;
+        };
+
+        /**
+         * @brief Returns the canonical terms of a fraction.
+         */
+        template <typename IntT, typename Precision>
+        constexpr CanonicalTerms<IntT> canonical(const BasicFraction<IntT, Precision> &fraction) noexcept
+        {
+            using UInt = typename FractionTraits<IntT>::unsigned_type;
+
+            // Every fraction is kept canonical, so the terms are taken as they are
+            return {static_cast<UInt>(fraction.getNumerator()), static_cast<UInt>(fraction.getDenominator())};
+        }
+
+        // The splitmix64 finalizer: every input bit affects every output bit
+        constexpr std::uint64_t mix(std::uint64_t value) noexcept
+        {
+            value ^= value >> 30U;
+            value *= 0xBF58476D1CE4E5B9ULL;
+            value ^= value >> 27U;
+            value *= 0x94D049BB133111EBULL;
+            value ^= value >> 31U;
+            return value;
+        }
+
+        // Folds a term of up to 128 bits into 64
+        template <typename UInt>
+        constexpr std::uint64_t fold(UInt value) noexcept
+        {
+            if constexpr (sizeof(UInt) > sizeof(std::uint64_t))
+            {
+                return mix(static_cast<std::uint64_t>(value >> 64U)) ^ static_cast<std::uint64_t>(value);
+            }
+            else
+            {
+                return static_cast<std::uint64_t>(value);
+            }
+        }
+
+        /**
+         * @brief Hashes a fraction by its canonical terms.
+         */
+        template <typename IntT, typename Precision>
+        constexpr std::uint64_t hash(const BasicFraction<IntT, Precision> &fraction) noexcept
+        {
+            CanonicalTerms<IntT> terms = canonical(fraction);
+            if constexpr (sizeof(IntT) <= sizeof(std::uint32_t))
+            {
+                // Both terms fit in one word, so the packing is injective
+                return mix(fold(terms.numerator) << 32U | fold(terms.denominator));
+            }
+            else
+            {
+                return mix(mix(fold(terms.numerator)) ^ fold(terms.denominator));
+            }
+        }
+    }
+
+    /**
+     * @brief A map from fractions to values, with open addressing and linear probing.
+     *
+     * The slots are one array of keys and values and a parallel array of one-byte tags. A tag is zero for an
+     * empty slot and otherwise holds seven bits of the key's hash, so a probe compares a byte before it
+     * touches a key. Lookups need no allocation and no string conversion. Erasing shifts the rest of the
+     * probe run back, so there are no tombstones and the map never needs to be rebuilt after erasures.
+     *
+     * Keys are compared exactly, by their canonical terms. T must be default constructible; a slot holds a
+     * default value while it is empty. Inserting may rehash, which invalidates pointers to values.
+     */
+    template <typename T, typename FractionT = Fraction>
+    class FractionHashMap
+    {
+    public:
+        struct Entry
+        {
+            FractionT key;
+            T value;
+        };
+
+    private:
+        std::vector<Entry> slots;
+        std::vector<std::uint8_t> tags;
+        std::size_t count = 0;
+
+        static constexpr std::uint8_t tag_of(std::uint64_t hash) noexcept
+        {
+            return static_cast<std::uint8_t>(0x80U | (hash >> 57U));
+        }
+
+        std::size_t mask() const noexcept
+        {
+            return tags.size() - 1;
+        }
+
+        // The slot of key, or of the empty slot that ends its probe run
+        std::size_t probe(const FractionT &key, std::uint64_t hash) const noexcept
+        {
+            auto terms = hashing::canonical(key);
+            std::uint8_t tag = tag_of(hash);
+            std::size_t index = static_cast<std::size_t>(hash) & mask();
+            while (tags[index] != 0 && (tags[index] != tag || hashing::canonical(slots[index].key) != terms))
+            {
+                index = (index + 1) & mask();
+            }
+            return index;
+        }
+
+        // Rebuilds the table with capacity slots, a power of two
+        void rehash(std::size_t capacity)
+        {
+            std::vector<Entry> old_slots(capacity);
+            std::vector<std::uint8_t> old_tags(capacity, 0);
+            old_slots.swap(slots);
+            old_tags.swap(tags);
+            for (std::size_t i = 0; i < old_tags.size(); ++i)
+            {
+                if (old_tags[i] != 0)
+                {
+                    std::size_t index = static_cast<std::size_t>(hashing::hash(old_slots[i].key)) & mask();
+                    while (tags[index] != 0)
+                    {
+                        index = (index + 1) & mask();
+                    }
+                    tags[index] = old_tags[i];
+                    slots[index] = std::move(old_slots[i]);
+                }
+            }
+        }
+
+        // Keeps the load factor at or below 3/4 with one more entry
+        void grow_for_one()
+        {
+            if ((count + 1) * 4 > tags.size() * 3)
+            {
+                rehash(tags.empty() ? 16 : tags.size() * 2);
+            }
+        }
+
+    public:
+        FractionHashMap() = default;
+
+        /**
+         * @brief Creates an empty map that holds expected entries without rehashing.
+         */
+        explicit FractionHashMap(std::size_t expected)
+        {
+            reserve(expected);
+        }
+
+        std::size_t size() const noexcept { return count; }
+        bool empty() const noexcept { return count == 0; }
+
+        /**
+         * @brief Makes room for expected entries without rehashing.
+         */
+        void reserve(std::size_t expected)
+        {
+            std::size_t capacity = 16;
+            while (capacity * 3 < expected * 4)
+            {
+                capacity *= 2;
+            }
+            if (capacity > tags.size())
+            {
+                rehash(capacity);
+            }
+        }
+
+        /**
+         * @brief Removes every entry, keeping the capacity.
+         */
+        void clear()
+        {
+            for (std::size_t i = 0; i < tags.size(); ++i)
+            {
+                if (tags[i] != 0)
+                {
+                    tags[i] = 0;
+                    slots[i] = Entry{};
+                }
+            }
+            count = 0;
+        }
+
+        /**
+         * @brief Returns the value of key, or nullptr if the map has none.
+         */
+        T *find(const FractionT &key) noexcept
+        {
+            if (count == 0)
+            {
+                return nullptr;
+            }
+            std::size_t index = probe(key, hashing::hash(key));
+            return tags[index] != 0 ? &slots[index].value : nullptr;
+        }
+
+        const T *find(const FractionT &key) const noexcept
+        {
+            return const_cast<FractionHashMap *>(this)->find(key);
+        }
+
+        bool contains(const FractionT &key) const noexcept
+        {
+            return find(key) != nullptr;
+        }
+
+        /**
+         * @brief Inserts value under key unless the key is present.
+         *
+         * @return The value under key, and whether it was inserted.
+         */
+        std::pair<T *, bool> insert(const FractionT &key, T value)
+        {
+            grow_for_one();
+            std::uint64_t hash = hashing::hash(key);
+            std::size_t index = probe(key, hash);
+            if (tags[index] != 0)
+            {
+                return {&slots[index].value, false};
+            }
+            tags[index] = tag_of(hash);
+            slots[index].key = key;
+            slots[index].value = std::move(value);
+            ++count;
+            return {&slots[index].value, true};
+        }
+
+        /**
+         * @brief Returns the value under key, inserting a default value if the key is absent.
+         */
+        T &operator[](const FractionT &key)
+        {
+            return *insert(key, T{}).first;
+        }
+
+        /**
+         * @brief Removes key and its value.
+         *
+         * @return true if the key was present.
+         */
+        bool erase(const FractionT &key)
+        {
+            if (count == 0)
+            {
+                return false;
+            }
+            std::size_t hole = probe(key, hashing::hash(key));
+            if (tags[hole] == 0)
+            {
+                return false;
+            }
+
+            // Move back every later entry of the run that may live in the hole: one whose home slot is not
+            // cyclically within (hole, index]
+            for (std::size_t index = (hole + 1) & mask(); tags[index] != 0; index = (index + 1) & mask())
+            {
+                std::size_t home = static_cast<std::size_t>(hashing::hash(slots[index].key)) & mask();
+                if (((index - home) & mask()) >= ((index - hole) & mask()))
+                {
+                    tags[hole] = tags[index];
+                    slots[hole] = std::move(slots[index]);
+                    hole = index;
+                }
+            }
+            tags[hole] = 0;
+            slots[hole] = Entry{};
+            --count;
+            return true;
+        }
+
+        /**
+         * @brief Calls function(key, value) for every entry, in no particular order.
+         */
+        template <typename Function>
+        void for_each(Function function) const
+        {
+            for (std::size_t i = 0; i < tags.size(); ++i)
+            {
+                if (tags[i] != 0)
+                {
+                    function(slots[i].key, slots[i].value);
+                }
+            }
+        }
+    };
+}
+
+namespace std
+{
+    /**
+     * @brief Hashes a fraction by its canonical terms.
+     */
+    template <typename IntT, typename Precision>
+    struct hash<ariel::BasicFraction<IntT, Precision>>
+    {
+        std::size_t operator()(const ariel::BasicFraction<IntT, Precision> &fraction) const noexcept
+        {
+            return static_cast<std::size_t>(ariel::hashing::hash(fraction));
+        }
+    };
+}
+
+#endif
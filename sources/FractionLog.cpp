@@ -0,0 +1,172 @@
+/**
+ * @file FractionLog.cpp
+ * @brief Implementation file for the Fraction logging sinks.
+ *
+ * The RingSink is a bounded multi-producer queue in the style of Dmitry Vyukov's MPMC queue: every slot
+ * carries a sequence number that tells producers and the consumer whether the slot is free or filled,
+ * so neither side ever takes a lock.
+ */
+
+#include "FractionLog.hpp"
+
+#include <cstring> // For strncpy
+#include <string>  // For the drain buffer
+
+using namespace ariel::logging;
+
+namespace
+{
+    // The sink currently receiving messages - nullptr means std::cout
+    std::atomic<RingSink *> active_sink{nullptr};
+
+    // Prefix printed in front of every message
+    const char *const PREFIX = "[Fraction]: ";
+}
+
+/**
+ * @brief Creates a sink holding up to capacity messages (rounded up to a power of two).
+ *
+ * @param capacity The requested number of messages.
+ */
+RingSink::RingSink(std::size_t capacity)
+{
+    // Round the capacity up to a power of two so positions can be wrapped with a mask
+    std::size_t size = 2;
+    while (size < capacity)
+    {
+        size <<= 1U;
+    }
+    mask = size - 1;
+    records = std::make_unique<Record[]>(size);
+
+    // Slot i is free for the producer that claims position i
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        records[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Appends a message to the buffer. Safe to call concurrently from any thread.
+ *
+ * @param level The severity of the message.
+ * @param message The message to store.
+ * @return true if the message was stored, false if the buffer was full and the message was dropped.
+ */
+bool RingSink::push(Level level, const char *message) noexcept
+{
+    std::size_t pos = head.load(std::memory_order_relaxed);
+    Record *record = nullptr;
+
+    // Claim a free slot
+    for (;;)
+    {
+        record = &records[pos & mask];
+        std::size_t sequence = record->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence - pos);
+
+        if (diff == 0)
+        {
+            if (head.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer has not caught up - drop the message rather than block
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            pos = head.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Fill the slot and publish it to the consumer
+    record->level = level;
+    std::strncpy(record->text, message, MESSAGE_SIZE - 1);
+    record->text[MESSAGE_SIZE - 1] = '\0';
+    record->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+ * @brief Removes every buffered message and writes them to the stream with a single write call.
+ *
+ * @param ostrm The stream to write the messages to.
+ * @return The number of messages written.
+ */
+std::size_t RingSink::drain(std::ostream &ostrm)
+{
+    std::string batch;
+    std::size_t count = 0;
+    std::size_t pos = tail.load(std::memory_order_relaxed);
+
+    for (;;)
+    {
+        Record &record = records[pos & mask];
+        std::size_t sequence = record.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(sequence - (pos + 1));
+
+        if (diff < 0)
+        {
+            // The next slot has not been published yet - the buffer is empty
+            break;
+        }
+        if (diff > 0 || !tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+        {
+            pos = tail.load(std::memory_order_relaxed);
+            continue;
+        }
+
+        // Copy the message out and hand the slot back to the producers
+        batch += PREFIX;
+        batch += record.text;
+        batch += '\n';
+        record.sequence.store(pos + mask + 1, std::memory_order_release);
+        ++pos;
+        ++count;
+    }
+
+    ostrm.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    return count;
+}
+
+/**
+ * @brief The number of messages dropped because the buffer was full.
+ */
+std::size_t RingSink::dropped() const noexcept
+{
+    return dropped_count.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Installs a sink for all log messages, or restores std::cout when sink is nullptr.
+ *
+ * @param sink The sink to install.
+ */
+void ariel::logging::set_sink(RingSink *sink) noexcept
+{
+    active_sink.store(sink, std::memory_order_release);
+}
+
+/**
+ * @brief Sends a message to the installed sink, or to std::cout if there is none.
+ *
+ * @param level The severity of the message.
+ * @param message The message to log.
+ */
+void ariel::logging::write(Level level, const char *message) noexcept
+{
+    RingSink *sink = active_sink.load(std::memory_order_acquire);
+    if (sink != nullptr)
+    {
+        sink->push(level, message);
+        return;
+    }
+
+    // No sink installed - print directly, without flushing on every line
+    std::cout << PREFIX << message << '\n';
+}
@@ -0,0 +1,123 @@
+/**
+ * @file FractionLog.hpp
+ * @brief Compile-time switchable logging for the Fraction class.
+ *
+ * The amount of logging compiled into the library is selected with the FRACTION_LOG_LEVEL macro
+ * (0 = off, 1 = errors, 2 = info, 3 = trace). The default is 0, so a release build of ariel::Fraction
+ * performs no I/O at all: every log call is discarded by `if constexpr` before it reaches the optimizer.
+ *
+ * When logging is compiled in, messages go to std::cout unless a RingSink is installed with set_sink().
+ * A RingSink is a bounded lock-free queue that collects messages from any number of threads without
+ * blocking them; the trace is written out in one batch by calling drain().
+ */
+
+#ifndef FRACTION_LOG_HPP
+#define FRACTION_LOG_HPP
+
+#include <atomic>   // For the lock-free ring buffer
+#include <cstddef>  // For std::size_t
+#include <iostream> // For output streams
+#include <memory>   // For std::unique_ptr
+
+#ifndef FRACTION_LOG_LEVEL
+#define FRACTION_LOG_LEVEL 0
+#endif
+
+namespace ariel
+{
+    namespace logging
+    {
+        /**
+         * @brief Severity of a log message. A message is compiled in only if its level is at most FRACTION_LOG_LEVEL.
+         */
+        enum class Level : int
+        {
+            Off = 0,
+            Error = 1,
+            Info = 2,
+            Trace = 3
+        };
+
+        /**
+         * @brief True if messages of the given level are compiled into this build.
+         */
+        template <Level L>
+        constexpr bool enabled = L != Level::Off && static_cast<int>(L) <= FRACTION_LOG_LEVEL;
+
+        /**
+         * @brief A bounded multi-producer lock-free ring buffer of log messages.
+         *
+         * push() never blocks and never allocates: when the buffer is full the message is dropped and counted.
+         * Messages longer than MESSAGE_SIZE - 1 characters are truncated.
+         */
+        class RingSink
+        {
+        public:
+            static constexpr std::size_t MESSAGE_SIZE = 120;
+
+            /**
+             * @brief Creates a sink holding up to capacity messages (rounded up to a power of two).
+             */
+            explicit RingSink(std::size_t capacity = 1024);
+
+            /**
+             * @brief Appends a message to the buffer. Safe to call concurrently from any thread.
+             *
+             * @return true if the message was stored, false if the buffer was full and the message was dropped.
+             */
+            bool push(Level level, const char *message) noexcept;
+
+            /**
+             * @brief Removes every buffered message and writes them to the stream with a single write call.
+             *
+             * @return The number of messages written.
+             */
+            std::size_t drain(std::ostream &ostrm);
+
+            /**
+             * @brief The number of messages dropped because the buffer was full.
+             */
+            std::size_t dropped() const noexcept;
+
+        private:
+            struct Record
+            {
+                std::atomic<std::size_t> sequence{0};
+                Level level = Level::Off;
+                char text[MESSAGE_SIZE] = {};
+            };
+
+            std::size_t mask;
+            std::unique_ptr<Record[]> records;
+            std::atomic<std::size_t> head{0};
+            std::atomic<std::size_t> tail{0};
+            std::atomic<std::size_t> dropped_count{0};
+        };
+
+        /**
+         * @brief Installs a sink for all log messages, or restores std::cout when sink is nullptr.
+         *
+         * The caller keeps ownership of the sink and must uninstall it before destroying it.
+         */
+        void set_sink(RingSink *sink) noexcept;
+
+        /**
+         * @brief Sends a message to the installed sink, or to std::cout if there is none.
+         */
+        void write(Level level, const char *message) noexcept;
+
+        /**
+         * @brief Logs a message at level L. Compiles to nothing unless L is enabled in this build.
+         */
+        template <Level L>
+        inline void log(const char *message) noexcept
+        {
+            if constexpr (enabled<L>)
+            {
+                write(L, message);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,276 @@
+/**
+ * @file FractionParser.hpp
+ * @brief A std::from_chars based parser for bulk fraction input.
+ *
+ * operator>> reads each term through the locale-aware stream extractors and reports errors by throwing.
+ * The functions here read directly from a character range with std::from_chars, accept the same two forms
+ * ("a/b" and "a b", separated by any whitespace) and return an error code with a pointer to where parsing
+ * stopped, in the manner of std::from_chars. Nothing is allocated and nothing is thrown, so a whole file can
+ * be parsed from memory in one pass. parse_fraction_lines reads the one-fraction-per-line file format.
+ */
+
+#ifndef FRACTION_PARSER_HPP
+#define FRACTION_PARSER_HPP
+
+#include "Fraction.hpp"
+
+#include <algorithm>   // For std::find
+#include <charconv>    // For std::from_chars
+#include <string_view> // For std::string_view
+
+namespace ariel
+{
+    /**
+     * @brief Why parsing a fraction failed.
+     */
+    enum class ParseError
+    {
+        None,            // A fraction was parsed
+        InvalidNumber,   // A term is missing or is not a decimal integer
+        ZeroDenominator, // The denominator is zero
+        OutOfRange,      // A term, or the reduced fraction, does not fit in an int
+        TrailingInput    // Characters follow the fraction in its string or on its line
+    };
+
+    /**
+     * @brief The outcome of a parse: where it stopped, and the error if there was one.
+     */
+    struct ParseResult
+    {
+        const char *ptr; // Past the parsed input on success, at the offending term on failure
+        ParseError error;
+    };
+
+    namespace parsing
+    {
+        constexpr bool is_space(char character) noexcept
+        {
+            return character == ' ' || character == '\n' || character == '\t' || character == '\r' ||
+                   character == '\v' || character == '\f';
+        }
+
+        // The separators allowed inside a line of a fraction file
+        constexpr bool is_blank(char character) noexcept
+        {
+            return character == ' ' || character == '\t';
+        }
+
+        constexpr const char *skip_spaces(const char *first, const char *last) noexcept
+        {
+            while (first != last && is_space(*first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        constexpr const char *skip_blanks(const char *first, const char *last) noexcept
+        {
+            while (first != last && is_blank(*first))
+            {
+                ++first;
+            }
+            return first;
+        }
+
+        // Reads one decimal term; a leading '+' is accepted as by the stream extractors
+        inline ParseResult parse_term(const char *first, const char *last, int &value) noexcept
+        {
+            const char *start = first;
+            if (first != last && *first == '+' && last - first > 1 && *(first + 1) != '-')
+            {
+                ++first;
+            }
+            auto [ptr, errc] = std::from_chars(first, last, value);
+            if (errc == std::errc::invalid_argument)
+            {
+                return {start, ParseError::InvalidNumber};
+            }
+            if (errc == std::errc::result_out_of_range)
+            {
+                return {start, ParseError::OutOfRange};
+            }
+            return {ptr, ParseError::None};
+        }
+
+        // Reads "a/b", or "a b" with the terms separated by characters for which is_separator holds, from the
+        // start of [first, last)
+        inline ParseResult parse_terms(const char *first, const char *last, Fraction &fraction, bool (*is_separator)(char) noexcept) noexcept
+        {
+            int numerator = 0;
+            int denominator = 1;
+            ParseResult result = parse_term(first, last, numerator);
+            if (result.error != ParseError::None)
+            {
+                return result;
+            }
+
+            // Either "a/b" with the slash right after the numerator, or "a b" with the terms separated
+            const char *next = result.ptr;
+            if (next != last && *next == '/')
+            {
+                ++next;
+            }
+            else if (next == last || !is_separator(*next))
+            {
+                return {next, ParseError::InvalidNumber};
+            }
+            while (next != last && is_separator(*next))
+            {
+                ++next;
+            }
+            result = parse_term(next, last, denominator);
+            if (result.error != ParseError::None)
+            {
+                return result;
+            }
+            if (denominator == 0)
+            {
+                return {next, ParseError::ZeroDenominator};
+            }
+
+            // Terms in range may still have no canonical form in int, as 1/INT_MIN
+            Checked<Fraction> made = Fraction::checked_make(numerator, denominator);
+            if (!made)
+            {
+                return {next, ParseError::OutOfRange};
+            }
+            fraction = made.value;
+            return result;
+        }
+    }
+
+    /**
+     * @brief Parses one fraction from the start of [first, last), after any leading whitespace.
+     *
+     * @param first The start of the input.
+     * @param last The end of the input.
+     * @param fraction Receives the parsed fraction, reduced; unchanged on failure.
+     * @return The end of the parsed fraction, or the error and where it was found.
+     */
+    inline ParseResult parse_fraction(const char *first, const char *last, Fraction &fraction) noexcept
+    {
+        return parsing::parse_terms(parsing::skip_spaces(first, last), last, fraction, parsing::is_space);
+    }
+
+    /**
+     * @brief Parses a string holding exactly one fraction, optionally surrounded by whitespace.
+     *
+     * @param text The text to parse.
+     * @param fraction Receives the parsed fraction, reduced; unchanged on failure.
+     * @return The error, if any, and where it was found.
+     */
+    inline ParseResult parse_fraction(std::string_view text, Fraction &fraction) noexcept
+    {
+        const char *last = text.data() + text.size();
+        Fraction parsed;
+        ParseResult result = parse_fraction(text.data(), last, parsed);
+        if (result.error != ParseError::None)
+        {
+            return result;
+        }
+        const char *rest = parsing::skip_spaces(result.ptr, last);
+        if (rest != last)
+        {
+            return {rest, ParseError::TrailingInput};
+        }
+        fraction = parsed;
+        return {last, ParseError::None};
+    }
+
+    /**
+     * @brief Parses a string holding exactly one fraction, as parse_fraction does, into a checked result.
+     *
+     * @param text The text to parse.
+     * @return The fraction; or ZeroDenominator, Overflow for a term or canonical form out of the range of int,
+     * or InvalidInput.
+     */
+    inline Checked<Fraction> checked_parse(std::string_view text) noexcept
+    {
+        Fraction fraction;
+        switch (parse_fraction(text, fraction).error)
+        {
+        case ParseError::None:
+            return {fraction};
+        case ParseError::ZeroDenominator:
+            return {Fraction(), FractionError::ZeroDenominator};
+        case ParseError::OutOfRange:
+            return {Fraction(), FractionError::Overflow};
+        default:
+            return {Fraction(), FractionError::InvalidInput};
+        }
+    }
+
+    /**
+     * @brief Parses whitespace-separated fractions until the end of the input or the first error.
+     *
+     * @param first The start of the input.
+     * @param last The end of the input.
+     * @param out Receives every parsed fraction in order.
+     * @return last if every fraction parsed, otherwise the first error and where it was found.
+     */
+    template <typename OutputIt>
+    ParseResult parse_fractions(const char *first, const char *last, OutputIt out)
+    {
+        for (first = parsing::skip_spaces(first, last); first != last; first = parsing::skip_spaces(first, last))
+        {
+            Fraction fraction;
+            ParseResult result = parse_fraction(first, last, fraction);
+            if (result.error != ParseError::None)
+            {
+                return result;
+            }
+            *out++ = fraction;
+            first = result.ptr;
+        }
+        return {last, ParseError::None};
+    }
+
+    /**
+     * @brief Parses one fraction per line until the end of the input or the first error.
+     *
+     * Unlike parse_fractions, a fraction never continues past the end of its line: the terms of the "a b"
+     * form may be separated only by spaces and tabs, and anything after the fraction on its line is an
+     * error. Blank lines are skipped and a '\r' before the '\n' is ignored, so the result depends only on
+     * the line, as splitting a file between threads requires.
+     *
+     * @param first The start of the input.
+     * @param last The end of the input.
+     * @param out Receives every parsed fraction in order.
+     * @return last if every line parsed, otherwise the first error and where it was found.
+     */
+    template <typename OutputIt>
+    ParseResult parse_fraction_lines(const char *first, const char *last, OutputIt out)
+    {
+        while (first != last)
+        {
+            const char *end = std::find(first, last, '\n');
+            const char *next = end == last ? last : end + 1;
+            if (end != first && *(end - 1) == '\r')
+            {
+                --end;
+            }
+
+            first = parsing::skip_blanks(first, end);
+            if (first != end)
+            {
+                Fraction fraction;
+                ParseResult result = parsing::parse_terms(first, end, fraction, parsing::is_blank);
+                if (result.error != ParseError::None)
+                {
+                    return result;
+                }
+                const char *rest = parsing::skip_blanks(result.ptr, end);
+                if (rest != end)
+                {
+                    return {rest, ParseError::TrailingInput};
+                }
+                *out++ = fraction;
+            }
+            first = next;
+        }
+        return {last, ParseError::None};
+    }
+}
+
+#endif
@@ -0,0 +1,91 @@
+/**
+ * @file FractionPool.cpp
+ * @brief Implementation file for the fraction interning table.
+ */
+
+#include "FractionPool.hpp"
+
+#include <mutex>     // For std::unique_lock
+#include <stdexcept> // For std::length_error
+
+using namespace ariel;
+
+FractionPool::FractionPool()
+    : chunks(new std::atomic<Fraction *>[MAX_CHUNKS])
+{
+    for (std::size_t i = 0; i < MAX_CHUNKS; ++i)
+    {
+        chunks[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+FractionPool::~FractionPool()
+{
+    for (std::size_t i = 0; i < MAX_CHUNKS; ++i)
+    {
+        delete[] chunks[i].load(std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Interns a fraction.
+ *
+ * @param fraction The fraction to intern.
+ * @return The handle of the fraction, the same for every equal fraction.
+ * @throws std::length_error if the pool is full.
+ */
+FractionPool::Handle FractionPool::intern(const Fraction &fraction)
+{
+    // A small fraction has a precomputed handle; fractions are canonical, so the denominator is positive
+    int numerator = fraction.getNumerator();
+    int denominator = fraction.getDenominator();
+    if (denominator <= pooling::SMALL_LIMIT && numerator >= -pooling::SMALL_LIMIT &&
+        numerator <= pooling::SMALL_LIMIT)
+    {
+        return Handle{pooling::SMALL_HANDLES[pooling::pair_index(numerator, denominator)]};
+    }
+
+    // Most lookups find a stored fraction, and share the lock
+    {
+        std::shared_lock<std::shared_mutex> lock(mutex);
+        if (const std::uint32_t *handle = handles.find(fraction))
+        {
+            return Handle{*handle};
+        }
+    }
+
+    // Another thread may have stored the fraction between the locks
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (const std::uint32_t *handle = handles.find(fraction))
+    {
+        return Handle{*handle};
+    }
+    if (stored == MAX_CHUNKS * CHUNK_SIZE)
+    {
+        throw std::length_error("The fraction pool is full");
+    }
+
+    // Store the fraction, allocating its chunk first if it is the chunk's first
+    std::size_t chunk = stored >> CHUNK_BITS;
+    Fraction *slots = chunks[chunk].load(std::memory_order_relaxed);
+    if (slots == nullptr)
+    {
+        slots = new Fraction[CHUNK_SIZE];
+        chunks[chunk].store(slots, std::memory_order_release);
+    }
+    slots[stored & (CHUNK_SIZE - 1)] = fraction;
+
+    auto index = static_cast<std::uint32_t>(pooling::SMALL_COUNT + stored);
+    handles.insert(fraction, index);
+    ++stored;
+    return Handle{index};
+}
+
+/**
+ * @brief Returns the number of fractions stored beyond the precomputed ones.
+ */
+std::size_t FractionPool::size() const
+{
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return stored;
+}
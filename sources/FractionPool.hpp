@@ -0,0 +1,191 @@
+/**
+ * @file FractionPool.hpp
+ * @brief An interning table that gives every distinct fraction one compact handle.
+ *
+ * Workloads that build the same few fractions over and over - 1/2, 1/3, 3/4 - can intern them instead:
+ * FractionPool::intern returns a 4-byte handle, equal handles mean equal fractions, and FractionPool::get
+ * returns the stored fraction. Every reduced fraction whose terms are at most SMALL_LIMIT in magnitude is
+ * precomputed at compile time, so interning one of those is a table lookup, with no GCD and no lock, even
+ * when the terms are not reduced. Other fractions are stored once in the pool as they are first interned.
+ *
+ * intern may be called from any number of threads. A handle is valid in the pool that returned it for the
+ * life of the pool, and get does not lock.
+ */
+
+#ifndef FRACTION_POOL_HPP
+#define FRACTION_POOL_HPP
+
+#include "Fraction.hpp"
+#include "FractionHash.hpp"
+
+#include <array>        // For the small-fraction tables
+#include <atomic>       // For the published chunks
+#include <cstdint>      // For std::uint32_t
+#include <memory>       // For std::unique_ptr
+#include <shared_mutex> // For the lookup lock
+
+namespace ariel
+{
+    namespace pooling
+    {
+        // The largest numerator magnitude and denominator of the precomputed fractions
+        constexpr int SMALL_LIMIT = 64;
+
+        // The number of (numerator, denominator) pairs with |numerator| and denominator up to SMALL_LIMIT
+        constexpr std::size_t SMALL_PAIRS = (2 * SMALL_LIMIT + 1) * SMALL_LIMIT;
+
+        // The index of a pair in the pair table; the denominator must be positive
+        constexpr std::size_t pair_index(int numerator, int denominator) noexcept
+        {
+            return static_cast<std::size_t>((numerator + SMALL_LIMIT) * SMALL_LIMIT + denominator - 1);
+        }
+
+        constexpr bool is_reduced(int numerator, int denominator) noexcept
+        {
+            return std::gcd(numerator, denominator) == 1;
+        }
+
+        // The number of distinct small fractions: the reduced pairs
+        constexpr std::size_t SMALL_COUNT = []
+        {
+            std::size_t count = 0;
+            for (int denominator = 1; denominator <= SMALL_LIMIT; ++denominator)
+            {
+                for (int numerator = -SMALL_LIMIT; numerator <= SMALL_LIMIT; ++numerator)
+                {
+                    count += is_reduced(numerator, denominator) ? 1U : 0U;
+                }
+            }
+            return count;
+        }();
+
+        // The small fractions in handle order
+        constexpr std::array<Fraction, SMALL_COUNT> SMALL_FRACTIONS = []
+        {
+            std::array<Fraction, SMALL_COUNT> fractions{};
+            std::size_t count = 0;
+            for (int denominator = 1; denominator <= SMALL_LIMIT; ++denominator)
+            {
+                for (int numerator = -SMALL_LIMIT; numerator <= SMALL_LIMIT; ++numerator)
+                {
+                    if (is_reduced(numerator, denominator))
+                    {
+                        fractions[count++] = Fraction(numerator, denominator);
+                    }
+                }
+            }
+            return fractions;
+        }();
+
+        // The handle of every small pair, reduced or not
+        constexpr std::array<std::uint16_t, SMALL_PAIRS> SMALL_HANDLES = []
+        {
+            std::array<std::uint16_t, SMALL_PAIRS> handles{};
+            std::uint16_t count = 0;
+            for (int denominator = 1; denominator <= SMALL_LIMIT; ++denominator)
+            {
+                for (int numerator = -SMALL_LIMIT; numerator <= SMALL_LIMIT; ++numerator)
+                {
+                    if (is_reduced(numerator, denominator))
+                    {
+                        handles[pair_index(numerator, denominator)] = count++;
+                    }
+                }
+            }
+
+            // An unreduced pair takes the handle of its reduced form, which has a smaller denominator
+            for (int denominator = 1; denominator <= SMALL_LIMIT; ++denominator)
+            {
+                for (int numerator = -SMALL_LIMIT; numerator <= SMALL_LIMIT; ++numerator)
+                {
+                    int common = std::gcd(numerator, denominator);
+                    handles[pair_index(numerator, denominator)] = handles[pair_index(numerator / common, denominator / common)];
+                }
+            }
+            return handles;
+        }();
+    }
+
+    /**
+     * @brief An interning table of fractions.
+     */
+    class FractionPool
+    {
+    public:
+        /**
+         * @brief The identity of an interned fraction in its pool.
+         */
+        struct Handle
+        {
+            std::uint32_t index;
+
+            constexpr bool operator==(const Handle &other) const noexcept = default;
+        };
+
+        // The dynamic fractions are stored in chunks that never move once published
+        static constexpr std::size_t CHUNK_BITS = 12;
+        static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << CHUNK_BITS;
+        static constexpr std::size_t MAX_CHUNKS = 4096;
+
+        FractionPool();
+        FractionPool(const FractionPool &other) = delete;
+        FractionPool &operator=(const FractionPool &other) = delete;
+        ~FractionPool();
+
+        /**
+         * @brief Interns numerator/denominator.
+         *
+         * @throws std::invalid_argument if the denominator is zero.
+         * @throws std::length_error if the pool is full.
+         */
+        Handle intern(int numerator, int denominator)
+        {
+            // Small terms are a table lookup, reduced or not
+            if (denominator < 0 && denominator >= -pooling::SMALL_LIMIT && numerator >= -pooling::SMALL_LIMIT &&
+                numerator <= pooling::SMALL_LIMIT)
+            {
+                numerator = -numerator;
+                denominator = -denominator;
+            }
+            if (denominator > 0 && denominator <= pooling::SMALL_LIMIT && numerator >= -pooling::SMALL_LIMIT &&
+                numerator <= pooling::SMALL_LIMIT)
+            {
+                return Handle{pooling::SMALL_HANDLES[pooling::pair_index(numerator, denominator)]};
+            }
+            return intern(Fraction(numerator, denominator));
+        }
+
+        /**
+         * @brief Interns a fraction.
+         *
+         * @throws std::length_error if the pool is full.
+         */
+        Handle intern(const Fraction &fraction);
+
+        /**
+         * @brief Returns the fraction of a handle returned by this pool.
+         */
+        const Fraction &get(Handle handle) const noexcept
+        {
+            if (handle.index < pooling::SMALL_COUNT)
+            {
+                return pooling::SMALL_FRACTIONS[handle.index];
+            }
+            std::size_t index = handle.index - pooling::SMALL_COUNT;
+            return chunks[index >> CHUNK_BITS].load(std::memory_order_acquire)[index & (CHUNK_SIZE - 1)];
+        }
+
+        /**
+         * @brief Returns the number of fractions stored beyond the precomputed ones.
+         */
+        std::size_t size() const;
+
+    private:
+        mutable std::shared_mutex mutex;
+        FractionHashMap<std::uint32_t> handles; // The handles of the stored fractions
+        std::size_t stored = 0;                 // The number of stored fractions
+        std::unique_ptr<std::atomic<Fraction *>[]> chunks;
+    };
+}
+
+#endif
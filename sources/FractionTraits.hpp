@@ -0,0 +1,226 @@
+/**
+ * @file FractionTraits.hpp
+ * @brief Per-width integer support for BasicFraction.
+ *
+ * BasicFraction<IntT> stores its terms in any signed integer of 8, 16, 32, 64 or 128 bits. FractionTraits
+ * selects, by width, the unsigned type used for GCDs and the wider type that intermediate products are
+ * computed in. Products of 8 to 64-bit terms always fit in the wide type; 128-bit terms have nothing wider,
+ * so their arithmetic falls back to overflow-checking builtins.
+ *
+ * The standard library does not support __int128 in strict mode (no numeric_limits, to_string or stream
+ * operators), so the limits and the decimal I/O helpers used by BasicFraction are defined here as well.
+ */
+
+#ifndef FRACTION_TRAITS_HPP
+#define FRACTION_TRAITS_HPP
+
+#include <cctype>      // For std::isdigit
+#include <charconv>    // For std::to_chars
+#include <cstddef>     // For std::size_t
+#include <cstdint>     // For the fixed-width integer types
+#include <iostream>    // For input/output streams
+#include <string>      // For string operations
+#include <type_traits> // For std::make_signed_t
+
+namespace ariel
+{
+    /**
+     * @brief The unsigned and wide types for terms of a given size in bytes.
+     */
+    template <std::size_t Bytes>
+    struct WidthTraits;
+
+    template <>
+    struct WidthTraits<1>
+    {
+        using unsigned_type = std::uint8_t;
+        using wide_type = std::int32_t;
+    };
+
+    template <>
+    struct WidthTraits<2>
+    {
+        using unsigned_type = std::uint16_t;
+        using wide_type = std::int64_t;
+    };
+
+    template <>
+    struct WidthTraits<4>
+    {
+        using unsigned_type = std::uint32_t;
+        using wide_type = std::int64_t;
+    };
+
+    template <>
+    struct WidthTraits<8>
+    {
+        using unsigned_type = std::uint64_t;
+        using wide_type = __int128;
+    };
+
+    template <>
+    struct WidthTraits<16>
+    {
+        using unsigned_type = unsigned __int128;
+        using wide_type = __int128;
+    };
+
+    /**
+     * @brief Properties of a signed integer type used as the terms of a BasicFraction.
+     */
+    template <typename IntT>
+    struct FractionTraits
+    {
+        static_assert(static_cast<IntT>(-1) < static_cast<IntT>(0), "fraction terms must be signed integers");
+
+        using unsigned_type = typename WidthTraits<sizeof(IntT)>::unsigned_type;
+        using wide_type = typename WidthTraits<sizeof(IntT)>::wide_type;
+
+        // True if the product of two terms always fits in wide_type
+        static constexpr bool widens = sizeof(wide_type) >= 2 * sizeof(IntT);
+
+        static constexpr IntT max_value = static_cast<IntT>(static_cast<unsigned_type>(static_cast<unsigned_type>(-1) >> 1U));
+        static constexpr IntT min_value = static_cast<IntT>(-max_value - 1);
+
+        // The number of decimal digits of the largest magnitude, ceil(bits * log10(2))
+        static constexpr std::size_t max_digits = (sizeof(IntT) * 8 * 30103 + 99999) / 100000;
+    };
+
+    /**
+     * @brief Writes an unsigned integer of any supported width in decimal, without a terminator. The buffer
+     * must have room for the max_digits of the signed type of the same width.
+     *
+     * @return A pointer past the last character written.
+     */
+    template <typename UInt>
+    char *format_unsigned(char *first, UInt value) noexcept
+    {
+        if constexpr (sizeof(UInt) <= sizeof(unsigned long long int))
+        {
+            return std::to_chars(first, first + FractionTraits<std::make_signed_t<UInt>>::max_digits, value).ptr;
+        }
+        else
+        {
+            // std::to_chars has no 128-bit overload: fill a scratch buffer from the end and copy it
+            char buffer[40];
+            char *digits = buffer + sizeof(buffer);
+            do
+            {
+                *--digits = static_cast<char>('0' + static_cast<int>(value % 10U));
+                value /= 10U;
+            } while (value != 0);
+            while (digits != buffer + sizeof(buffer))
+            {
+                *first++ = *digits++;
+            }
+            return first;
+        }
+    }
+
+    /**
+     * @brief Formats an integer of any supported width in decimal.
+     */
+    template <typename IntT>
+    std::string to_decimal(IntT value)
+    {
+        if constexpr (sizeof(IntT) <= sizeof(long long int))
+        {
+            return std::to_string(static_cast<long long int>(value));
+        }
+        else
+        {
+            using UInt = typename FractionTraits<IntT>::unsigned_type;
+            UInt magnitude = value < 0 ? static_cast<UInt>(0U - static_cast<UInt>(value)) : static_cast<UInt>(value);
+
+            // Fill the buffer from the end, least significant digit first
+            char buffer[48];
+            char *first = buffer + sizeof(buffer);
+            do
+            {
+                *--first = static_cast<char>('0' + static_cast<int>(magnitude % 10U));
+                magnitude /= 10U;
+            } while (magnitude != 0);
+            if (value < 0)
+            {
+                *--first = '-';
+            }
+            return std::string(first, buffer + sizeof(buffer));
+        }
+    }
+
+    /**
+     * @brief Writes an integer of any supported width to a stream in decimal. 8-bit values are printed as
+     * numbers, not characters.
+     */
+    template <typename IntT>
+    void write_integer(std::ostream &ostrm, IntT value)
+    {
+        if constexpr (sizeof(IntT) < sizeof(int))
+        {
+            ostrm << static_cast<int>(value);
+        }
+        else if constexpr (sizeof(IntT) <= sizeof(long long int))
+        {
+            ostrm << value;
+        }
+        else
+        {
+            ostrm << to_decimal(value);
+        }
+    }
+
+    /**
+     * @brief Reads a decimal integer of any supported width from a stream. Sets failbit if there is no
+     * number or if it does not fit in IntT.
+     */
+    template <typename IntT>
+    void read_integer(std::istream &istrm, IntT &value)
+    {
+        if constexpr (sizeof(IntT) <= sizeof(long long int))
+        {
+            long long int wide = 0;
+            if (istrm >> wide)
+            {
+                if (wide > FractionTraits<IntT>::max_value || wide < FractionTraits<IntT>::min_value)
+                {
+                    istrm.setstate(std::ios::failbit);
+                    return;
+                }
+                value = static_cast<IntT>(wide);
+            }
+        }
+        else
+        {
+            using UInt = typename FractionTraits<IntT>::unsigned_type;
+
+            // Parse the sign and digits by hand, checking each step against the magnitude limit
+            istrm >> std::ws;
+            bool negative = istrm.peek() == '-';
+            if (negative || istrm.peek() == '+')
+            {
+                istrm.get();
+            }
+            if (!std::isdigit(istrm.peek()))
+            {
+                istrm.setstate(std::ios::failbit);
+                return;
+            }
+
+            UInt limit = static_cast<UInt>(FractionTraits<IntT>::max_value) + (negative ? 1U : 0U);
+            UInt magnitude = 0;
+            while (std::isdigit(istrm.peek()))
+            {
+                auto digit = static_cast<UInt>(istrm.get() - '0');
+                if (magnitude > (limit - digit) / 10U)
+                {
+                    istrm.setstate(std::ios::failbit);
+                    return;
+                }
+                magnitude = magnitude * 10U + digit;
+            }
+            value = static_cast<IntT>(negative ? static_cast<UInt>(0U - magnitude) : magnitude);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,758 @@
+/**
+ * @file FractionVector.cpp
+ * @brief Implementation file for the FractionVector class and its SIMD kernels.
+ *
+ * Every operation has three kernels: scalar, SSE4 (four elements per step) and AVX2 (eight elements per
+ * step). The vector kernels widen the int terms to 64-bit lanes for the cross products, check every lane
+ * against the int range, and reduce with a lane-wise binary GCD. A sum or difference whose cross products
+ * overflow may still fit once reduced, so its lanes are recomputed by Fraction::checked_add and
+ * checked_sub, which add by the GCD of the denominators. The
+ * quotients of the reduction are exact, so they are computed by double division, which the vector units
+ * have and integer division lacks. Elements left over at the end of the arrays go through the scalar kernel.
+ * The vector kernels are only compiled for x86; elsewhere the scalar kernels are the only ones.
+ */
+
+#include "FractionVector.hpp"
+
+#include <algorithm> // For std::find
+#include <atomic>    // For the active instruction set
+
+// The vector kernels exist on x86 only; other targets always run the scalar kernels
+#if defined(__x86_64__) || defined(__i386__)
+#define FRACTION_X86_SIMD 1
+#else
+#define FRACTION_X86_SIMD 0
+#endif
+
+#if FRACTION_X86_SIMD
+#include <immintrin.h> // For the SSE4 and AVX2 intrinsics
+
+#define FRACTION_TARGET_SSE4 __attribute__((target("sse4.2")))
+#define FRACTION_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+using namespace ariel;
+
+namespace
+{
+    // The operand arrays of an element-wise operation
+    struct Operands
+    {
+        const int *lhs_num;
+        const int *lhs_den;
+        const int *rhs_num;
+        const int *rhs_den;
+    };
+
+    // The result arrays of an element-wise operation
+    struct Results
+    {
+        int *num;
+        int *den;
+    };
+
+    enum class Op
+    {
+        Add,
+        Subtract,
+        Multiply,
+        Divide
+    };
+
+    // ********** Scalar kernels **********
+
+    unsigned int magnitude(int value) noexcept
+    {
+        return value < 0 ? 0U - static_cast<unsigned int>(value) : static_cast<unsigned int>(value);
+    }
+
+    long long int common_factor(int first, int second) noexcept
+    {
+        return static_cast<long long int>(gcd::compute(magnitude(first), magnitude(second)));
+    }
+
+    bool fits(long long int value) noexcept
+    {
+        return value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max();
+    }
+
+    // Computes a sum or difference through Fraction, which overflows only if the reduced result does not
+    // fit; returns false if it overflows
+    template <Op O>
+    bool fraction_element(int lhs_num, int lhs_den, int rhs_num, int rhs_den, int &num, int &den)
+    {
+        // The terms are canonical, so constructing the operands cannot throw
+        Fraction lhs(lhs_num, lhs_den);
+        Fraction rhs(rhs_num, rhs_den);
+        Checked<Fraction> result = O == Op::Add ? Fraction::checked_add(lhs, rhs) : Fraction::checked_sub(lhs, rhs);
+        if (!result)
+        {
+            return false;
+        }
+        num = result.value.getNumerator();
+        den = result.value.getDenominator();
+        return true;
+    }
+
+    // Computes one element; returns false if it overflows
+    template <Op O>
+    bool scalar_element(int lhs_num, int lhs_den, int rhs_num, int rhs_den, int &num, int &den)
+    {
+        long long int wide_num = 0;
+        long long int wide_den = 0;
+        if constexpr (O == Op::Add || O == Op::Subtract)
+        {
+            long long int left = static_cast<long long int>(lhs_num) * rhs_den;
+            long long int right = static_cast<long long int>(rhs_num) * lhs_den;
+            wide_num = O == Op::Add ? left + right : left - right;
+            wide_den = static_cast<long long int>(lhs_den) * rhs_den;
+            if (!fits(wide_num) || !fits(wide_den))
+            {
+                return fraction_element<O>(lhs_num, lhs_den, rhs_num, rhs_den, num, den);
+            }
+
+            // The unreduced terms fit - reduce them
+            auto common = static_cast<long long int>(gcd::compute(magnitude(static_cast<int>(wide_num)), static_cast<unsigned int>(wide_den)));
+            num = static_cast<int>(wide_num / common);
+            den = static_cast<int>(wide_den / common);
+            return true;
+        }
+        else
+        {
+            // Multiplication by rhs, or by its reciprocal, with common factors cancelled across the operands
+            int mul_num = O == Op::Multiply ? rhs_num : rhs_den;
+            int mul_den = O == Op::Multiply ? rhs_den : rhs_num;
+            long long int cross1 = common_factor(lhs_num, mul_den);
+            long long int cross2 = common_factor(mul_num, lhs_den);
+            wide_num = (lhs_num / cross1) * (mul_num / cross2);
+            wide_den = (lhs_den / cross2) * (mul_den / cross1);
+            if (wide_den < 0)
+            {
+                wide_num = -wide_num;
+                wide_den = -wide_den;
+            }
+            if (!fits(wide_num) || !fits(wide_den))
+            {
+                return false;
+            }
+            num = static_cast<int>(wide_num);
+            den = static_cast<int>(wide_den);
+            return true;
+        }
+    }
+
+    template <Op O>
+    bool scalar_kernel(const Operands &in, const Results &out, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            if (!scalar_element<O>(in.lhs_num[i], in.lhs_den[i], in.rhs_num[i], in.rhs_den[i], out.num[i], out.den[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Recomputes the lanes of the block at begin whose cross products overflow, through Fraction; returns
+    // false if one of them overflows there too
+    template <Op O>
+    bool retry_lanes(const Operands &in, const Results &out, std::size_t begin, unsigned int lanes)
+    {
+        for (; lanes != 0; lanes &= lanes - 1)
+        {
+            std::size_t i = begin + static_cast<std::size_t>(__builtin_ctz(lanes));
+            if (!fraction_element<O>(in.lhs_num[i], in.lhs_den[i], in.rhs_num[i], in.rhs_den[i], out.num[i], out.den[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void scalar_compare(const Operands &in, int *out, std::size_t begin, std::size_t end)
+    {
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            // Denominators are positive, so cross-multiplying keeps the order
+            long long int left = static_cast<long long int>(in.lhs_num[i]) * in.rhs_den[i];
+            long long int right = static_cast<long long int>(in.rhs_num[i]) * in.lhs_den[i];
+            out[i] = (left > right) - (left < right);
+        }
+    }
+
+#if FRACTION_X86_SIMD
+    // ********** SSE4 kernels - four elements per step **********
+
+    // Divides every nonzero lane by its largest power of two. SSE has no per-lane variable shifts, so the
+    // trailing zeros are stripped by halving steps: 16, 8, 4, 2 and 1 bits, each blended into the lanes
+    // whose low bits are all zero.
+    FRACTION_TARGET_SSE4 inline __m128i strip_twos_sse4(__m128i value)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i nonzero = _mm_xor_si128(_mm_cmpeq_epi32(value, zero), _mm_set1_epi32(-1));
+        for (int bits = 16; bits > 0; bits /= 2)
+        {
+            __m128i low_mask = _mm_set1_epi32((1 << bits) - 1);
+            __m128i even = _mm_and_si128(nonzero, _mm_cmpeq_epi32(_mm_and_si128(value, low_mask), zero));
+            value = _mm_blendv_epi8(value, _mm_srl_epi32(value, _mm_cvtsi32_si128(bits)), even);
+        }
+        return value;
+    }
+
+    // Lane-wise gcd of unsigned 32-bit values - Stein's algorithm
+    FRACTION_TARGET_SSE4 inline __m128i gcd_sse4(__m128i u, __m128i v)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i one = _mm_set1_epi32(1);
+
+        // gcd(x, 0) = gcd(0, x) = x; those lanes run the loop on (1, 1) and are patched at the end
+        __m128i either_zero = _mm_or_si128(_mm_cmpeq_epi32(u, zero), _mm_cmpeq_epi32(v, zero));
+        __m128i fallback = _mm_or_si128(u, v);
+        u = _mm_blendv_epi8(u, one, either_zero);
+        v = _mm_blendv_epi8(v, one, either_zero);
+
+        // The common power of two is the lowest set bit of u | v
+        __m128i both = _mm_or_si128(u, v);
+        __m128i common_twos = _mm_and_si128(both, _mm_sub_epi32(zero, both));
+
+        u = strip_twos_sse4(u);
+        while (!_mm_testz_si128(v, v))
+        {
+            v = strip_twos_sse4(v);
+            v = _mm_blendv_epi8(v, u, _mm_cmpeq_epi32(v, zero));
+            __m128i low = _mm_min_epu32(u, v);
+            __m128i high = _mm_max_epu32(u, v);
+            u = low;
+            v = _mm_sub_epi32(high, low);
+        }
+        return _mm_blendv_epi8(_mm_mullo_epi32(u, common_twos), fallback, either_zero);
+    }
+
+    // value / divisor for exact quotients, through double division
+    FRACTION_TARGET_SSE4 inline __m128i divide_exact_sse4(__m128i value, __m128i divisor)
+    {
+        __m128i low = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(value), _mm_cvtepi32_pd(divisor)));
+        __m128i high = _mm_cvttpd_epi32(_mm_div_pd(_mm_cvtepi32_pd(_mm_srli_si128(value, 8)), _mm_cvtepi32_pd(_mm_srli_si128(divisor, 8))));
+        return _mm_unpacklo_epi64(low, high);
+    }
+
+    // Sign-extends lanes 0-1 (half 0) or 2-3 (half 1) to 64 bits
+    FRACTION_TARGET_SSE4 inline __m128i widen_sse4(__m128i value, int half)
+    {
+        return _mm_cvtepi32_epi64(half == 0 ? value : _mm_srli_si128(value, 8));
+    }
+
+    // All-ones in the 64-bit lanes outside the int range
+    FRACTION_TARGET_SSE4 inline __m128i out_of_range_sse4(__m128i value)
+    {
+        return _mm_or_si128(_mm_cmpgt_epi64(value, _mm_set1_epi64x(std::numeric_limits<int>::max())),
+                            _mm_cmpgt_epi64(_mm_set1_epi64x(std::numeric_limits<int>::min()), value));
+    }
+
+    // Packs the low 32 bits of two pairs of 64-bit lanes into four 32-bit lanes
+    FRACTION_TARGET_SSE4 inline __m128i narrow_sse4(__m128i low, __m128i high)
+    {
+        return _mm_unpacklo_epi64(_mm_shuffle_epi32(low, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_epi32(high, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    template <Op O>
+    FRACTION_TARGET_SSE4 bool sse4_kernel(const Operands &in, const Results &out, std::size_t size)
+    {
+        const std::size_t blocks = size - size % 4;
+        __m128i overflow = _mm_setzero_si128();
+        for (std::size_t i = 0; i < blocks; i += 4)
+        {
+            __m128i lhs_num = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.lhs_num + i));
+            __m128i lhs_den = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.lhs_den + i));
+            __m128i rhs_num = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.rhs_num + i));
+            __m128i rhs_den = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.rhs_den + i));
+            __m128i num;
+            __m128i den;
+            unsigned int retry = 0;
+
+            if constexpr (O == Op::Add || O == Op::Subtract)
+            {
+                __m128i wide_num[2];
+                __m128i wide_den[2];
+                __m128i lane_overflow[2];
+                for (int half = 0; half < 2; ++half)
+                {
+                    __m128i left = _mm_mul_epi32(widen_sse4(lhs_num, half), widen_sse4(rhs_den, half));
+                    __m128i right = _mm_mul_epi32(widen_sse4(rhs_num, half), widen_sse4(lhs_den, half));
+                    wide_num[half] = O == Op::Add ? _mm_add_epi64(left, right) : _mm_sub_epi64(left, right);
+                    wide_den[half] = _mm_mul_epi32(widen_sse4(lhs_den, half), widen_sse4(rhs_den, half));
+                    lane_overflow[half] = _mm_or_si128(out_of_range_sse4(wide_num[half]), out_of_range_sse4(wide_den[half]));
+                }
+                num = narrow_sse4(wide_num[0], wide_num[1]);
+                den = narrow_sse4(wide_den[0], wide_den[1]);
+
+                // The overflowing lanes are recomputed after the store
+                retry = static_cast<unsigned int>(_mm_movemask_ps(_mm_castsi128_ps(narrow_sse4(lane_overflow[0], lane_overflow[1]))));
+
+                __m128i common = gcd_sse4(_mm_abs_epi32(num), den);
+                num = divide_exact_sse4(num, common);
+                den = divide_exact_sse4(den, common);
+            }
+            else
+            {
+                __m128i mul_num = O == Op::Multiply ? rhs_num : rhs_den;
+                __m128i mul_den = O == Op::Multiply ? rhs_den : rhs_num;
+                __m128i cross1 = gcd_sse4(_mm_abs_epi32(lhs_num), _mm_abs_epi32(mul_den));
+                __m128i cross2 = gcd_sse4(_mm_abs_epi32(mul_num), lhs_den);
+                // A cross factor of 2^31 (both terms INT_MIN) reads as -2^31 and flips a and d together;
+                // the sign normalization below undoes it
+                __m128i a = divide_exact_sse4(lhs_num, cross1);
+                __m128i b = divide_exact_sse4(mul_num, cross2);
+                __m128i c = divide_exact_sse4(lhs_den, cross2);
+                __m128i d = divide_exact_sse4(mul_den, cross1);
+
+                __m128i wide_num[2];
+                __m128i wide_den[2];
+                for (int half = 0; half < 2; ++half)
+                {
+                    __m128i product_num = _mm_mul_epi32(widen_sse4(a, half), widen_sse4(b, half));
+                    __m128i product_den = _mm_mul_epi32(widen_sse4(c, half), widen_sse4(d, half));
+
+                    // Move the sign of a negative divisor to the numerator
+                    __m128i flip = _mm_cmpgt_epi64(_mm_setzero_si128(), product_den);
+                    product_num = _mm_blendv_epi8(product_num, _mm_sub_epi64(_mm_setzero_si128(), product_num), flip);
+                    product_den = _mm_blendv_epi8(product_den, _mm_sub_epi64(_mm_setzero_si128(), product_den), flip);
+
+                    wide_num[half] = product_num;
+                    wide_den[half] = product_den;
+                    overflow = _mm_or_si128(overflow, _mm_or_si128(out_of_range_sse4(product_num), out_of_range_sse4(product_den)));
+                }
+                num = narrow_sse4(wide_num[0], wide_num[1]);
+                den = narrow_sse4(wide_den[0], wide_den[1]);
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out.num + i), num);
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out.den + i), den);
+            if (retry != 0 && !retry_lanes<O>(in, out, i, retry))
+            {
+                return false;
+            }
+        }
+        return _mm_testz_si128(overflow, overflow) && scalar_kernel<O>(in, out, blocks, size);
+    }
+
+    FRACTION_TARGET_SSE4 void sse4_compare(const Operands &in, int *out, std::size_t size)
+    {
+        const std::size_t blocks = size - size % 4;
+        for (std::size_t i = 0; i < blocks; i += 4)
+        {
+            __m128i lhs_num = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.lhs_num + i));
+            __m128i lhs_den = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.lhs_den + i));
+            __m128i rhs_num = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.rhs_num + i));
+            __m128i rhs_den = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in.rhs_den + i));
+
+            __m128i result[2];
+            for (int half = 0; half < 2; ++half)
+            {
+                __m128i left = _mm_mul_epi32(widen_sse4(lhs_num, half), widen_sse4(rhs_den, half));
+                __m128i right = _mm_mul_epi32(widen_sse4(rhs_num, half), widen_sse4(lhs_den, half));
+
+                // The comparison masks are -1 where true, so less - greater is the three-way result
+                result[half] = _mm_sub_epi64(_mm_cmpgt_epi64(right, left), _mm_cmpgt_epi64(left, right));
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), narrow_sse4(result[0], result[1]));
+        }
+        scalar_compare(in, out, blocks, size);
+    }
+
+    // ********** AVX2 kernels - eight elements per step **********
+
+    // Count of trailing zeros per 32-bit lane: the lowest set bit is a power of two, which converts to a
+    // float exactly, so its exponent is the count. Zero lanes give a count above 31, which shifts to zero.
+    FRACTION_TARGET_AVX2 inline __m256i count_trailing_zeros_avx2(__m256i value)
+    {
+        __m256i lowest = _mm256_and_si256(value, _mm256_sub_epi32(_mm256_setzero_si256(), value));
+        __m256i bits = _mm256_castps_si256(_mm256_cvtepi32_ps(lowest));
+        __m256i exponent = _mm256_and_si256(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(0xFF));
+        return _mm256_sub_epi32(exponent, _mm256_set1_epi32(127));
+    }
+
+    // Lane-wise gcd of unsigned 32-bit values - Stein's algorithm with per-lane variable shifts
+    FRACTION_TARGET_AVX2 inline __m256i gcd_avx2(__m256i u, __m256i v)
+    {
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i one = _mm256_set1_epi32(1);
+
+        // gcd(x, 0) = gcd(0, x) = x; those lanes run the loop on (1, 1) and are patched at the end
+        __m256i either_zero = _mm256_or_si256(_mm256_cmpeq_epi32(u, zero), _mm256_cmpeq_epi32(v, zero));
+        __m256i fallback = _mm256_or_si256(u, v);
+        u = _mm256_blendv_epi8(u, one, either_zero);
+        v = _mm256_blendv_epi8(v, one, either_zero);
+
+        __m256i shift = count_trailing_zeros_avx2(_mm256_or_si256(u, v));
+        u = _mm256_srlv_epi32(u, count_trailing_zeros_avx2(u));
+        while (!_mm256_testz_si256(v, v))
+        {
+            // Lanes that are already done (v == 0) compare u with itself and stay done
+            v = _mm256_srlv_epi32(v, count_trailing_zeros_avx2(v));
+            v = _mm256_blendv_epi8(v, u, _mm256_cmpeq_epi32(v, zero));
+            __m256i low = _mm256_min_epu32(u, v);
+            __m256i high = _mm256_max_epu32(u, v);
+            u = low;
+            v = _mm256_sub_epi32(high, low);
+        }
+        return _mm256_blendv_epi8(_mm256_sllv_epi32(u, shift), fallback, either_zero);
+    }
+
+    // value / divisor for exact quotients, through double division
+    FRACTION_TARGET_AVX2 inline __m256i divide_exact_avx2(__m256i value, __m256i divisor)
+    {
+        __m128i low = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(value)),
+                                                        _mm256_cvtepi32_pd(_mm256_castsi256_si128(divisor))));
+        __m128i high = _mm256_cvttpd_epi32(_mm256_div_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(value, 1)),
+                                                         _mm256_cvtepi32_pd(_mm256_extracti128_si256(divisor, 1))));
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+    }
+
+    // Sign-extends lanes 0-3 (half 0) or 4-7 (half 1) to 64 bits
+    FRACTION_TARGET_AVX2 inline __m256i widen_avx2(__m256i value, int half)
+    {
+        return _mm256_cvtepi32_epi64(half == 0 ? _mm256_castsi256_si128(value) : _mm256_extracti128_si256(value, 1));
+    }
+
+    // All-ones in the 64-bit lanes outside the int range
+    FRACTION_TARGET_AVX2 inline __m256i out_of_range_avx2(__m256i value)
+    {
+        return _mm256_or_si256(_mm256_cmpgt_epi64(value, _mm256_set1_epi64x(std::numeric_limits<int>::max())),
+                               _mm256_cmpgt_epi64(_mm256_set1_epi64x(std::numeric_limits<int>::min()), value));
+    }
+
+    // Packs the low 32 bits of two groups of four 64-bit lanes into eight 32-bit lanes
+    FRACTION_TARGET_AVX2 inline __m256i narrow_avx2(__m256i low, __m256i high)
+    {
+        const __m256i even_lanes = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+        __m128i packed_low = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(low, even_lanes));
+        __m128i packed_high = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(high, even_lanes));
+        return _mm256_inserti128_si256(_mm256_castsi128_si256(packed_low), packed_high, 1);
+    }
+
+    template <Op O>
+    FRACTION_TARGET_AVX2 bool avx2_kernel(const Operands &in, const Results &out, std::size_t size)
+    {
+        const std::size_t blocks = size - size % 8;
+        __m256i overflow = _mm256_setzero_si256();
+        for (std::size_t i = 0; i < blocks; i += 8)
+        {
+            __m256i lhs_num = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.lhs_num + i));
+            __m256i lhs_den = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.lhs_den + i));
+            __m256i rhs_num = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.rhs_num + i));
+            __m256i rhs_den = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.rhs_den + i));
+            __m256i num;
+            __m256i den;
+            unsigned int retry = 0;
+
+            if constexpr (O == Op::Add || O == Op::Subtract)
+            {
+                __m256i wide_num[2];
+                __m256i wide_den[2];
+                __m256i lane_overflow[2];
+                for (int half = 0; half < 2; ++half)
+                {
+                    __m256i left = _mm256_mul_epi32(widen_avx2(lhs_num, half), widen_avx2(rhs_den, half));
+                    __m256i right = _mm256_mul_epi32(widen_avx2(rhs_num, half), widen_avx2(lhs_den, half));
+                    wide_num[half] = O == Op::Add ? _mm256_add_epi64(left, right) : _mm256_sub_epi64(left, right);
+                    wide_den[half] = _mm256_mul_epi32(widen_avx2(lhs_den, half), widen_avx2(rhs_den, half));
+                    lane_overflow[half] = _mm256_or_si256(out_of_range_avx2(wide_num[half]), out_of_range_avx2(wide_den[half]));
+                }
+                num = narrow_avx2(wide_num[0], wide_num[1]);
+                den = narrow_avx2(wide_den[0], wide_den[1]);
+
+                // The overflowing lanes are recomputed after the store
+                retry = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(narrow_avx2(lane_overflow[0], lane_overflow[1]))));
+
+                __m256i common = gcd_avx2(_mm256_abs_epi32(num), den);
+                num = divide_exact_avx2(num, common);
+                den = divide_exact_avx2(den, common);
+            }
+            else
+            {
+                __m256i mul_num = O == Op::Multiply ? rhs_num : rhs_den;
+                __m256i mul_den = O == Op::Multiply ? rhs_den : rhs_num;
+                __m256i cross1 = gcd_avx2(_mm256_abs_epi32(lhs_num), _mm256_abs_epi32(mul_den));
+                __m256i cross2 = gcd_avx2(_mm256_abs_epi32(mul_num), lhs_den);
+                // A cross factor of 2^31 (both terms INT_MIN) reads as -2^31 and flips a and d together;
+                // the sign normalization below undoes it
+                __m256i a = divide_exact_avx2(lhs_num, cross1);
+                __m256i b = divide_exact_avx2(mul_num, cross2);
+                __m256i c = divide_exact_avx2(lhs_den, cross2);
+                __m256i d = divide_exact_avx2(mul_den, cross1);
+
+                __m256i wide_num[2];
+                __m256i wide_den[2];
+                for (int half = 0; half < 2; ++half)
+                {
+                    __m256i product_num = _mm256_mul_epi32(widen_avx2(a, half), widen_avx2(b, half));
+                    __m256i product_den = _mm256_mul_epi32(widen_avx2(c, half), widen_avx2(d, half));
+
+                    // Move the sign of a negative divisor to the numerator
+                    __m256i flip = _mm256_cmpgt_epi64(_mm256_setzero_si256(), product_den);
+                    product_num = _mm256_blendv_epi8(product_num, _mm256_sub_epi64(_mm256_setzero_si256(), product_num), flip);
+                    product_den = _mm256_blendv_epi8(product_den, _mm256_sub_epi64(_mm256_setzero_si256(), product_den), flip);
+
+                    wide_num[half] = product_num;
+                    wide_den[half] = product_den;
+                    overflow = _mm256_or_si256(overflow, _mm256_or_si256(out_of_range_avx2(product_num), out_of_range_avx2(product_den)));
+                }
+                num = narrow_avx2(wide_num[0], wide_num[1]);
+                den = narrow_avx2(wide_den[0], wide_den[1]);
+            }
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.num + i), num);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out.den + i), den);
+            if (retry != 0 && !retry_lanes<O>(in, out, i, retry))
+            {
+                return false;
+            }
+        }
+        return _mm256_testz_si256(overflow, overflow) && scalar_kernel<O>(in, out, blocks, size);
+    }
+
+    FRACTION_TARGET_AVX2 void avx2_compare(const Operands &in, int *out, std::size_t size)
+    {
+        const std::size_t blocks = size - size % 8;
+        for (std::size_t i = 0; i < blocks; i += 8)
+        {
+            __m256i lhs_num = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.lhs_num + i));
+            __m256i lhs_den = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.lhs_den + i));
+            __m256i rhs_num = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.rhs_num + i));
+            __m256i rhs_den = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in.rhs_den + i));
+
+            __m256i result[2];
+            for (int half = 0; half < 2; ++half)
+            {
+                __m256i left = _mm256_mul_epi32(widen_avx2(lhs_num, half), widen_avx2(rhs_den, half));
+                __m256i right = _mm256_mul_epi32(widen_avx2(rhs_num, half), widen_avx2(lhs_den, half));
+
+                // The comparison masks are -1 where true, so less - greater is the three-way result
+                result[half] = _mm256_sub_epi64(_mm256_cmpgt_epi64(right, left), _mm256_cmpgt_epi64(left, right));
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), narrow_avx2(result[0], result[1]));
+        }
+        scalar_compare(in, out, blocks, size);
+    }
+
+#endif
+
+    // ********** Dispatch **********
+
+    simd::Isa detect_isa() noexcept
+    {
+#if FRACTION_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return simd::Isa::AVX2;
+        }
+        if (__builtin_cpu_supports("sse4.2"))
+        {
+            return simd::Isa::SSE4;
+        }
+#endif
+        return simd::Isa::Scalar;
+    }
+
+    std::atomic<simd::Isa> &active() noexcept
+    {
+        static std::atomic<simd::Isa> isa{detect_isa()};
+        return isa;
+    }
+
+    template <Op O>
+    bool run_kernel(const Operands &in, const Results &out, std::size_t size)
+    {
+        switch (active().load(std::memory_order_relaxed))
+        {
+#if FRACTION_X86_SIMD
+        case simd::Isa::AVX2:
+            return avx2_kernel<O>(in, out, size);
+        case simd::Isa::SSE4:
+            return sse4_kernel<O>(in, out, size);
+#endif
+        default:
+            return scalar_kernel<O>(in, out, 0, size);
+        }
+    }
+
+    void check_sizes(const FractionVector &lhs, const FractionVector &rhs)
+    {
+        if (lhs.size() != rhs.size())
+        {
+            throw std::invalid_argument("Vectors must have the same size");
+        }
+    }
+
+    Operands operands(const FractionVector &lhs, const FractionVector &rhs) noexcept
+    {
+        return Operands{lhs.numerator_data(), lhs.denominator_data(), rhs.numerator_data(), rhs.denominator_data()};
+    }
+}
+
+// ********** Instruction set selection **********
+
+simd::Isa simd::best_isa() noexcept
+{
+    static const Isa best = detect_isa();
+    return best;
+}
+
+simd::Isa simd::active_isa() noexcept
+{
+    return active().load(std::memory_order_relaxed);
+}
+
+void simd::set_isa(Isa isa) noexcept
+{
+    active().store(static_cast<int>(isa) <= static_cast<int>(best_isa()) ? isa : best_isa(), std::memory_order_relaxed);
+}
+
+// ********** FractionVector **********
+
+/**
+ * @brief Creates a vector of size zeros.
+ *
+ * @param size The number of elements.
+ */
+FractionVector::FractionVector(std::size_t size)
+    : numerators(size, 0), denominators(size, 1)
+{
+}
+
+/**
+ * @brief Creates a vector holding the given fractions.
+ *
+ * @param fractions The elements.
+ */
+FractionVector::FractionVector(std::initializer_list<Fraction> fractions)
+{
+    reserve(fractions.size());
+    for (const Fraction &fraction : fractions)
+    {
+        push_back(fraction);
+    }
+}
+
+void FractionVector::reserve(std::size_t capacity)
+{
+    numerators.reserve(capacity);
+    denominators.reserve(capacity);
+}
+
+/**
+ * @brief Appends a fraction.
+ *
+ * @param fraction The fraction to append.
+ */
+void FractionVector::push_back(const Fraction &fraction)
+{
+    // Fractions are canonical, so the terms are stored as they are
+    numerators.push_back(fraction.getNumerator());
+    denominators.push_back(fraction.getDenominator());
+}
+
+/**
+ * @brief Returns element index as a Fraction.
+ *
+ * @param index The index of the element.
+ */
+Fraction FractionVector::operator[](std::size_t index) const
+{
+    return Fraction(numerators[index], denominators[index]);
+}
+
+/**
+ * @brief Replaces element index.
+ *
+ * @param index The index of the element.
+ * @param fraction The new value.
+ */
+void FractionVector::set(std::size_t index, const Fraction &fraction)
+{
+    numerators[index] = fraction.getNumerator();
+    denominators[index] = fraction.getDenominator();
+}
+
+namespace ariel
+{
+    FractionVector operator+(const FractionVector &lhs, const FractionVector &rhs)
+    {
+        check_sizes(lhs, rhs);
+        FractionVector result(lhs.size());
+        if (!run_kernel<Op::Add>(operands(lhs, rhs), Results{result.numerators.data(), result.denominators.data()}, lhs.size()))
+        {
+            Fraction::error_overflow();
+        }
+        return result;
+    }
+
+    FractionVector operator-(const FractionVector &lhs, const FractionVector &rhs)
+    {
+        check_sizes(lhs, rhs);
+        FractionVector result(lhs.size());
+        if (!run_kernel<Op::Subtract>(operands(lhs, rhs), Results{result.numerators.data(), result.denominators.data()}, lhs.size()))
+        {
+            Fraction::error_overflow();
+        }
+        return result;
+    }
+
+    FractionVector operator*(const FractionVector &lhs, const FractionVector &rhs)
+    {
+        check_sizes(lhs, rhs);
+        FractionVector result(lhs.size());
+        if (!run_kernel<Op::Multiply>(operands(lhs, rhs), Results{result.numerators.data(), result.denominators.data()}, lhs.size()))
+        {
+            Fraction::error_overflow();
+        }
+        return result;
+    }
+
+    FractionVector operator/(const FractionVector &lhs, const FractionVector &rhs)
+    {
+        check_sizes(lhs, rhs);
+        if (std::find(rhs.numerators.begin(), rhs.numerators.end(), 0) != rhs.numerators.end())
+        {
+            Fraction::error_zero();
+        }
+        FractionVector result(lhs.size());
+        if (!run_kernel<Op::Divide>(operands(lhs, rhs), Results{result.numerators.data(), result.denominators.data()}, lhs.size()))
+        {
+            Fraction::error_overflow();
+        }
+        return result;
+    }
+}
+
+/**
+ * @brief Element-wise three-way comparison.
+ *
+ * @param lhs The left-hand vector.
+ * @param rhs The right-hand vector.
+ * @return For every index, -1 if lhs < rhs, 0 if they are equal, and 1 if lhs > rhs.
+ */
+std::vector<int> FractionVector::compare(const FractionVector &lhs, const FractionVector &rhs)
+{
+    check_sizes(lhs, rhs);
+    std::vector<int> result(lhs.size());
+    Operands in = operands(lhs, rhs);
+    switch (active().load(std::memory_order_relaxed))
+    {
+#if FRACTION_X86_SIMD
+    case simd::Isa::AVX2:
+        avx2_compare(in, result.data(), lhs.size());
+        break;
+    case simd::Isa::SSE4:
+        sse4_compare(in, result.data(), lhs.size());
+        break;
+#endif
+    default:
+        scalar_compare(in, result.data(), 0, lhs.size());
+        break;
+    }
+    return result;
+}
@@ -0,0 +1,143 @@
+/**
+ * @file FractionVector.hpp
+ * @brief Header file for the FractionVector class, a structure-of-arrays container for batch arithmetic.
+ *
+ * A FractionVector stores the numerators and the denominators of its elements in two separate int arrays,
+ * so element-wise operations can load eight numerators or eight denominators with one instruction.
+ * Add, subtract, multiply, divide and compare run as AVX2 or SSE4 kernels - including a vectorized
+ * binary GCD for the reduction - with a scalar fallback. The kernel set is chosen at run time from the
+ * features of the CPU and can be overridden with simd::set_isa. On targets other than x86, only the scalar
+ * kernels are built and every instruction set resolves to them.
+ *
+ * Elements are kept reduced with a positive denominator. The results and exceptions are the same as
+ * those of the Fraction operators applied element by element.
+ */
+
+#ifndef FRACTION_VECTOR_HPP
+#define FRACTION_VECTOR_HPP
+
+#include "Fraction.hpp"
+
+#include <initializer_list> // For list initialization
+#include <vector>           // For the term arrays
+
+namespace ariel
+{
+    namespace simd
+    {
+        /**
+         * @brief The instruction sets FractionVector has kernels for.
+         */
+        enum class Isa
+        {
+            Scalar = 0,
+            SSE4 = 1,
+            AVX2 = 2
+        };
+
+        /**
+         * @brief The best instruction set supported by this CPU.
+         */
+        Isa best_isa() noexcept;
+
+        /**
+         * @brief The instruction set the FractionVector kernels currently use.
+         */
+        Isa active_isa() noexcept;
+
+        /**
+         * @brief Selects the kernels to use, e.g. to compare them in tests. Requests for an instruction set
+         * the CPU does not support fall back to the best supported one.
+         */
+        void set_isa(Isa isa) noexcept;
+    }
+
+    class FractionVector
+    {
+    private:
+        std::vector<int> numerators;   // The numerators of the elements
+        std::vector<int> denominators; // The denominators of the elements - always positive
+
+    public:
+        /**
+         * @brief Creates an empty vector.
+         */
+        FractionVector() = default;
+
+        /**
+         * @brief Creates a vector of size zeros.
+         */
+        explicit FractionVector(std::size_t size);
+
+        /**
+         * @brief Creates a vector holding the given fractions.
+         */
+        FractionVector(std::initializer_list<Fraction> fractions);
+
+        std::size_t size() const noexcept { return numerators.size(); }
+        bool empty() const noexcept { return numerators.empty(); }
+        void reserve(std::size_t capacity);
+
+        /**
+         * @brief Appends a fraction.
+         */
+        void push_back(const Fraction &fraction);
+
+        /**
+         * @brief Returns element index as a Fraction.
+         */
+        Fraction operator[](std::size_t index) const;
+
+        /**
+         * @brief Replaces element index.
+         */
+        void set(std::size_t index, const Fraction &fraction);
+
+        // Direct access to the term arrays
+        const int *numerator_data() const noexcept { return numerators.data(); }
+        const int *denominator_data() const noexcept { return denominators.data(); }
+
+        /**
+         * @brief Element-wise sum.
+         *
+         * @throws std::invalid_argument if the sizes differ.
+         * @throws std::overflow_error if an element overflows, exactly as Fraction::operator+ would.
+         */
+        friend FractionVector operator+(const FractionVector &lhs, const FractionVector &rhs);
+
+        /**
+         * @brief Element-wise difference.
+         *
+         * @throws std::invalid_argument if the sizes differ.
+         * @throws std::overflow_error if an element overflows, exactly as Fraction::operator- would.
+         */
+        friend FractionVector operator-(const FractionVector &lhs, const FractionVector &rhs);
+
+        /**
+         * @brief Element-wise product, with common factors cancelled across the operands first.
+         *
+         * @throws std::invalid_argument if the sizes differ.
+         * @throws std::overflow_error if an element overflows, exactly as Fraction::operator* would.
+         */
+        friend FractionVector operator*(const FractionVector &lhs, const FractionVector &rhs);
+
+        /**
+         * @brief Element-wise quotient.
+         *
+         * @throws std::invalid_argument if the sizes differ.
+         * @throws std::runtime_error if an element of rhs is zero.
+         * @throws std::overflow_error if an element overflows, exactly as Fraction::operator/ would.
+         */
+        friend FractionVector operator/(const FractionVector &lhs, const FractionVector &rhs);
+
+        /**
+         * @brief Element-wise three-way comparison.
+         *
+         * @return For every index, -1 if lhs < rhs, 0 if they are equal, and 1 if lhs > rhs.
+         * @throws std::invalid_argument if the sizes differ.
+         */
+        static std::vector<int> compare(const FractionVector &lhs, const FractionVector &rhs);
+    };
+}
+
+#endif
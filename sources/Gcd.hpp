@@ -0,0 +1,142 @@
+/**
+ * @file Gcd.hpp
+ * @brief Greatest common divisor engines used to reduce fractions.
+ *
+ * Two engines are provided: the classic modulo-based Euclid loop, and Stein's binary GCD which replaces
+ * every division with shifts by the count of trailing zeros and a subtraction. The engine used by
+ * Fraction::reduce is selected at compile time with FRACTION_GCD_ENGINE (0 = Euclid, 1 = binary, the default);
+ * either engine can also be called directly through gcd::compute<Engine>.
+ */
+
+#ifndef GCD_HPP
+#define GCD_HPP
+
+#ifndef FRACTION_GCD_ENGINE
+#define FRACTION_GCD_ENGINE 1
+#endif
+
+namespace ariel
+{
+    namespace gcd
+    {
+        /**
+         * @brief The available GCD algorithms.
+         */
+        enum class Engine
+        {
+            Euclid = 0,
+            Binary = 1
+        };
+
+        /**
+         * @brief The engine used by Fraction::reduce in this build.
+         */
+        constexpr Engine default_engine = static_cast<Engine>(FRACTION_GCD_ENGINE);
+
+        /**
+         * @brief Counts the trailing zero bits of a non-zero value.
+         */
+        constexpr int count_trailing_zeros(unsigned char value) noexcept
+        {
+            return __builtin_ctz(value);
+        }
+
+        constexpr int count_trailing_zeros(unsigned short value) noexcept
+        {
+            return __builtin_ctz(value);
+        }
+
+        constexpr int count_trailing_zeros(unsigned int value) noexcept
+        {
+            return __builtin_ctz(value);
+        }
+
+        constexpr int count_trailing_zeros(unsigned long value) noexcept
+        {
+            return __builtin_ctzl(value);
+        }
+
+        constexpr int count_trailing_zeros(unsigned long long value) noexcept
+        {
+            return __builtin_ctzll(value);
+        }
+
+        constexpr int count_trailing_zeros(unsigned __int128 value) noexcept
+        {
+            auto low = static_cast<unsigned long long>(value);
+            return low != 0 ? __builtin_ctzll(low) : 64 + __builtin_ctzll(static_cast<unsigned long long>(value >> 64U));
+        }
+
+        /**
+         * @brief Euclid's algorithm: repeatedly replaces (a, b) with (b, a mod b).
+         *
+         * @return gcd(a, b), with gcd(0, 0) = 0.
+         */
+        template <typename UInt>
+        constexpr UInt euclid(UInt a, UInt b) noexcept
+        {
+            static_assert(static_cast<UInt>(-1) > static_cast<UInt>(0), "gcd engines work on unsigned magnitudes");
+            while (b != 0)
+            {
+                UInt rem = static_cast<UInt>(a % b);
+                a = b;
+                b = rem;
+            }
+            return a;
+        }
+
+        /**
+         * @brief Stein's binary GCD: strips factors of two with count-trailing-zeros and subtracts the smaller
+         * odd value from the larger one until they meet. The min/max step compiles to conditional moves.
+         *
+         * @return gcd(a, b), with gcd(0, 0) = 0.
+         */
+        template <typename UInt>
+        constexpr UInt binary(UInt a, UInt b) noexcept
+        {
+            static_assert(static_cast<UInt>(-1) > static_cast<UInt>(0), "gcd engines work on unsigned magnitudes");
+            if (a == 0)
+            {
+                return b;
+            }
+            if (b == 0)
+            {
+                return a;
+            }
+
+            // The common power of two is restored at the end. Casts undo the promotion of 8 and 16-bit operands.
+            int shift = count_trailing_zeros(static_cast<UInt>(a | b));
+            a = static_cast<UInt>(a >> count_trailing_zeros(a));
+
+            // Invariant: a is odd
+            do
+            {
+                b = static_cast<UInt>(b >> count_trailing_zeros(b));
+                UInt low = a < b ? a : b;
+                UInt high = a < b ? b : a;
+                a = low;
+                b = static_cast<UInt>(high - low);
+            } while (b != 0);
+
+            return static_cast<UInt>(a << shift);
+        }
+
+        /**
+         * @brief Computes gcd(a, b) with the selected engine.
+         */
+        template <Engine E = default_engine, typename UInt>
+        constexpr UInt compute(UInt a, UInt b) noexcept
+        {
+            if constexpr (E == Engine::Binary)
+            {
+                return binary(a, b);
+            }
+            else
+            {
+                return euclid(a, b);
+            }
+        }
+    }
+}
+
+#endif
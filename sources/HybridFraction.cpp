@@ -0,0 +1,186 @@
+/**
+ * @file HybridFraction.cpp
+ * @brief Implementation file for the HybridFraction class - construction and the BigFraction slow paths.
+ */
+
+#include "HybridFraction.hpp"
+
+using namespace ariel;
+
+/**
+ * @brief Creates the fraction numerator / denominator.
+ *
+ * @param input_numerator The numerator of the fraction.
+ * @param input_denominator The denominator of the fraction.
+ *
+ * @throws std::invalid_argument if the denominator is zero.
+ */
+HybridFraction::HybridFraction(long long int input_numerator, long long int input_denominator)
+{
+    if (input_denominator == 0)
+    {
+        throw std::invalid_argument("Denominator can't be zero");
+    }
+
+    // Move the sign to the numerator; negating the minimum long long needs the big representation
+    if (input_denominator < 0)
+    {
+        long long int num = 0;
+        long long int denom = 0;
+        if (__builtin_sub_overflow(0LL, input_numerator, &num) | __builtin_sub_overflow(0LL, input_denominator, &denom))
+        {
+            *this = from_big(BigFraction(BigInt(input_numerator), BigInt(input_denominator)));
+            return;
+        }
+        input_numerator = num;
+        input_denominator = denom;
+    }
+    set_inline(input_numerator, input_denominator, false);
+}
+
+/**
+ * @brief Converts a Fraction exactly.
+ *
+ * @param fraction The fraction to convert.
+ */
+HybridFraction::HybridFraction(const Fraction &fraction)
+{
+    // Fraction is already canonical: reduced, with a positive denominator
+    set_inline(fraction.getNumerator(), fraction.getDenominator(), true);
+}
+
+/**
+ * @brief Converts a BigFraction exactly, storing it inline if it fits.
+ *
+ * @param fraction The fraction to convert.
+ */
+HybridFraction::HybridFraction(const BigFraction &fraction)
+{
+    *this = from_big(fraction);
+}
+
+HybridFraction::HybridFraction(const HybridFraction &other)
+    : numerator(other.numerator), denominator(other.denominator),
+      big(other.big ? std::make_unique<BigFraction>(*other.big) : nullptr)
+{
+}
+
+HybridFraction &HybridFraction::operator=(const HybridFraction &other)
+{
+    if (this != &other)
+    {
+        numerator = other.numerator;
+        denominator = other.denominator;
+        big = other.big ? std::make_unique<BigFraction>(*other.big) : nullptr;
+    }
+    return *this;
+}
+
+// A moved-from fraction is left as zero, since a zero denominator without a BigFraction would be invalid
+HybridFraction::HybridFraction(HybridFraction &&other) noexcept
+    : numerator(other.numerator), denominator(other.denominator), big(std::move(other.big))
+{
+    other.numerator = 0;
+    other.denominator = 1;
+}
+
+HybridFraction &HybridFraction::operator=(HybridFraction &&other) noexcept
+{
+    if (this != &other)
+    {
+        numerator = other.numerator;
+        denominator = other.denominator;
+        big = std::move(other.big);
+        other.numerator = 0;
+        other.denominator = 1;
+    }
+    return *this;
+}
+
+/**
+ * @brief Creates the result of an operation that overflowed, demoting it if the reduced value fits.
+ *
+ * @param value The exact result, reduced with a positive denominator.
+ * @return The result, inline if both terms fit in a long long.
+ */
+HybridFraction HybridFraction::from_big(BigFraction value)
+{
+    HybridFraction result;
+    if (value.getNumerator().fits_int64() && value.getDenominator().fits_int64())
+    {
+        result.set_inline(value.getNumerator().to_int64(), value.getDenominator().to_int64(), true);
+    }
+    else
+    {
+        result.big = std::make_unique<BigFraction>(std::move(value));
+        result.denominator = 0;
+    }
+    return result;
+}
+
+HybridFraction HybridFraction::add_big(const HybridFraction &lhs, const HybridFraction &rhs)
+{
+    return from_big(lhs.to_big() + rhs.to_big());
+}
+
+HybridFraction HybridFraction::subtract_big(const HybridFraction &lhs, const HybridFraction &rhs)
+{
+    return from_big(lhs.to_big() - rhs.to_big());
+}
+
+HybridFraction HybridFraction::multiply_big(const HybridFraction &lhs, const HybridFraction &rhs)
+{
+    return from_big(lhs.to_big() * rhs.to_big());
+}
+
+HybridFraction HybridFraction::divide_big(const HybridFraction &lhs, const HybridFraction &rhs)
+{
+    return from_big(lhs.to_big() / rhs.to_big());
+}
+
+int HybridFraction::compare_big(const HybridFraction &lhs, const HybridFraction &rhs)
+{
+    return BigFraction::compare(lhs.to_big(), rhs.to_big());
+}
+
+/**
+ * @brief Converts to a BigFraction.
+ *
+ * @return The same value as a BigFraction.
+ */
+BigFraction HybridFraction::to_big() const
+{
+    if (big)
+    {
+        return *big;
+    }
+    return BigFraction(BigInt(numerator), BigInt(denominator));
+}
+
+/**
+ * @brief Converts to a Fraction.
+ *
+ * @return The same value as a Fraction.
+ * @throws std::overflow_error if a term does not fit in an int.
+ */
+Fraction HybridFraction::to_fraction() const
+{
+    if (big || numerator > std::numeric_limits<int>::max() || numerator < std::numeric_limits<int>::min() ||
+        denominator > std::numeric_limits<int>::max())
+    {
+        Fraction::error_overflow();
+    }
+    return Fraction(static_cast<int>(numerator), static_cast<int>(denominator));
+}
+
+/**
+ * @brief Converts to a double.
+ */
+double HybridFraction::to_double() const noexcept
+{
+    if (big)
+    {
+        return big->to_double();
+    }
+    return static_cast<double>(numerator) / static_cast<double>(denominator);
+}
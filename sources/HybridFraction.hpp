@@ -0,0 +1,276 @@
+/**
+ * @file HybridFraction.hpp
+ * @brief A fraction that stores small values inline and promotes to a BigFraction on overflow.
+ *
+ * A HybridFraction keeps its numerator and denominator in two long longs. Every operation computes the
+ * result with __builtin_*_overflow and tests the combined overflow flag once: on the common path the cost
+ * is the same as Fraction arithmetic. Only when a term would overflow is the operation redone on
+ * BigFractions; the result is stored on the heap and is demoted back to inline storage as soon as its
+ * reduced terms fit again. Unlike Fraction, no operation ever throws std::overflow_error.
+ *
+ * A promoted value keeps a zero inline denominator, so for + and - a big operand fails the same test as
+ * an overflow, and the pointer is only looked at out of line.
+ */
+
+#ifndef HYBRID_FRACTION_HPP
+#define HYBRID_FRACTION_HPP
+
+#include "BigFraction.hpp"
+#include "Gcd.hpp"
+
+#include <memory> // For std::unique_ptr
+
+namespace ariel
+{
+    class HybridFraction
+    {
+    private:
+        // The inline value, reduced with a positive denominator. The denominator is zero exactly when the
+        // value is big.
+        long long int numerator = 0;
+        long long int denominator = 1;
+
+        // The value when it does not fit inline
+        std::unique_ptr<BigFraction> big;
+
+        static constexpr unsigned long long magnitude(long long int value) noexcept
+        {
+            return value < 0 ? 0ULL - static_cast<unsigned long long>(value) : static_cast<unsigned long long>(value);
+        }
+
+        // gcd(|first|, |second|) - at least 1 when second is a denominator
+        static long long int common_factor(long long int first, long long int second) noexcept
+        {
+            return static_cast<long long int>(gcd::compute(magnitude(first), magnitude(second)));
+        }
+
+        // Stores num / denom, where denom is positive and both fit; reduces unless the caller already has
+        void set_inline(long long int num, long long int denom, bool reduced) noexcept
+        {
+            if (!reduced)
+            {
+                long long int common = common_factor(num, denom);
+                num /= common;
+                denom /= common;
+            }
+            numerator = num;
+            denominator = denom;
+        }
+
+        /**
+         * @brief Creates the result of an operation that overflowed, demoting it if the reduced value fits.
+         */
+        static HybridFraction from_big(BigFraction value);
+
+        // The slow paths, taken when an inline operation overflows or an operand is already big
+        static HybridFraction add_big(const HybridFraction &lhs, const HybridFraction &rhs);
+        static HybridFraction subtract_big(const HybridFraction &lhs, const HybridFraction &rhs);
+        static HybridFraction multiply_big(const HybridFraction &lhs, const HybridFraction &rhs);
+        static HybridFraction divide_big(const HybridFraction &lhs, const HybridFraction &rhs);
+        static int compare_big(const HybridFraction &lhs, const HybridFraction &rhs);
+
+    public:
+        /**
+         * @brief Creates the fraction zero.
+         */
+        HybridFraction() noexcept = default;
+
+        /**
+         * @brief Creates the fraction numerator / denominator.
+         *
+         * @throws std::invalid_argument if the denominator is zero.
+         */
+        HybridFraction(long long int numerator, long long int denominator);
+
+        /**
+         * @brief Converts a Fraction exactly.
+         */
+        HybridFraction(const Fraction &fraction);
+
+        /**
+         * @brief Converts a BigFraction exactly, storing it inline if it fits.
+         */
+        HybridFraction(const BigFraction &fraction);
+
+        HybridFraction(const HybridFraction &other);
+        HybridFraction(HybridFraction &&other) noexcept;
+        HybridFraction &operator=(const HybridFraction &other);
+        HybridFraction &operator=(HybridFraction &&other) noexcept;
+        ~HybridFraction() = default;
+
+        /**
+         * @brief Adds two fractions. Never throws std::overflow_error.
+         */
+        friend HybridFraction operator+(const HybridFraction &lhs, const HybridFraction &rhs)
+        {
+            // A big operand has a zero denominator, so the product of the denominators is zero exactly when
+            // an operand is big: one test covers that and overflow
+            long long int left = 0;
+            long long int right = 0;
+            long long int num = 0;
+            long long int denom = 0;
+            bool slow = __builtin_mul_overflow(lhs.numerator, rhs.denominator, &left) |
+                        __builtin_mul_overflow(rhs.numerator, lhs.denominator, &right) |
+                        __builtin_add_overflow(left, right, &num) |
+                        __builtin_mul_overflow(lhs.denominator, rhs.denominator, &denom) |
+                        (denom == 0);
+            if (slow) [[unlikely]]
+            {
+                return add_big(lhs, rhs);
+            }
+            HybridFraction result;
+            result.set_inline(num, denom, false);
+            return result;
+        }
+
+        /**
+         * @brief Subtracts two fractions. Never throws std::overflow_error.
+         */
+        friend HybridFraction operator-(const HybridFraction &lhs, const HybridFraction &rhs)
+        {
+            // A big operand has a zero denominator, so the product of the denominators is zero exactly when
+            // an operand is big: one test covers that and overflow
+            long long int left = 0;
+            long long int right = 0;
+            long long int num = 0;
+            long long int denom = 0;
+            bool slow = __builtin_mul_overflow(lhs.numerator, rhs.denominator, &left) |
+                        __builtin_mul_overflow(rhs.numerator, lhs.denominator, &right) |
+                        __builtin_sub_overflow(left, right, &num) |
+                        __builtin_mul_overflow(lhs.denominator, rhs.denominator, &denom) |
+                        (denom == 0);
+            if (slow) [[unlikely]]
+            {
+                return subtract_big(lhs, rhs);
+            }
+            HybridFraction result;
+            result.set_inline(num, denom, false);
+            return result;
+        }
+
+        /**
+         * @brief Multiplies two fractions, cancelling common factors across the operands first. Never throws
+         * std::overflow_error.
+         */
+        friend HybridFraction operator*(const HybridFraction &lhs, const HybridFraction &rhs)
+        {
+            // The cross factors are only defined for inline operands
+            if ((lhs.denominator != 0) & (rhs.denominator != 0))
+            {
+                long long int cross1 = common_factor(lhs.numerator, rhs.denominator);
+                long long int cross2 = common_factor(rhs.numerator, lhs.denominator);
+                long long int num = 0;
+                long long int denom = 0;
+                bool overflow = __builtin_mul_overflow(lhs.numerator / cross1, rhs.numerator / cross2, &num) |
+                                __builtin_mul_overflow(lhs.denominator / cross2, rhs.denominator / cross1, &denom);
+                if (!overflow)
+                {
+                    HybridFraction result;
+                    result.set_inline(num, denom, true);
+                    return result;
+                }
+            }
+            return multiply_big(lhs, rhs);
+        }
+
+        /**
+         * @brief Divides two fractions. Never throws std::overflow_error.
+         *
+         * @throws std::runtime_error if rhs is zero.
+         */
+        friend HybridFraction operator/(const HybridFraction &lhs, const HybridFraction &rhs)
+        {
+            if ((lhs.denominator != 0) & (rhs.denominator != 0))
+            {
+                if (rhs.numerator == 0)
+                {
+                    Fraction::error_zero();
+                }
+
+                // Multiply by the reciprocal, moving its sign to the numerator
+                long long int cross1 = common_factor(lhs.numerator, rhs.numerator);
+                long long int cross2 = common_factor(rhs.denominator, lhs.denominator);
+                long long int num = 0;
+                long long int denom = 0;
+                bool overflow = __builtin_mul_overflow(lhs.numerator / cross1, rhs.denominator / cross2, &num) |
+                                __builtin_mul_overflow(lhs.denominator / cross2, rhs.numerator / cross1, &denom);
+                if (denom < 0)
+                {
+                    overflow |= __builtin_sub_overflow(0LL, num, &num) | __builtin_sub_overflow(0LL, denom, &denom);
+                }
+                if (!overflow)
+                {
+                    HybridFraction result;
+                    result.set_inline(num, denom, true);
+                    return result;
+                }
+            }
+            return divide_big(lhs, rhs);
+        }
+
+        HybridFraction &operator+=(const HybridFraction &other) { return *this = *this + other; }
+        HybridFraction &operator-=(const HybridFraction &other) { return *this = *this - other; }
+        HybridFraction &operator*=(const HybridFraction &other) { return *this = *this * other; }
+        HybridFraction &operator/=(const HybridFraction &other) { return *this = *this / other; }
+
+        /**
+         * @brief Three-way comparison. Inline values are cross-multiplied in 128 bits.
+         *
+         * @return A negative value if lhs < rhs, zero if they are equal, and a positive value if lhs > rhs.
+         */
+        static int compare(const HybridFraction &lhs, const HybridFraction &rhs)
+        {
+            if ((lhs.denominator != 0) & (rhs.denominator != 0))
+            {
+                __int128 left = static_cast<__int128>(lhs.numerator) * rhs.denominator;
+                __int128 right = static_cast<__int128>(rhs.numerator) * lhs.denominator;
+                return (left > right) - (left < right);
+            }
+            return compare_big(lhs, rhs);
+        }
+
+        friend bool operator==(const HybridFraction &lhs, const HybridFraction &rhs) { return compare(lhs, rhs) == 0; }
+        friend bool operator!=(const HybridFraction &lhs, const HybridFraction &rhs) { return compare(lhs, rhs) != 0; }
+        friend bool operator<(const HybridFraction &lhs, const HybridFraction &rhs) { return compare(lhs, rhs) < 0; }
+        friend bool operator>(const HybridFraction &lhs, const HybridFraction &rhs) { return compare(lhs, rhs) > 0; }
+        friend bool operator<=(const HybridFraction &lhs, const HybridFraction &rhs) { return compare(lhs, rhs) <= 0; }
+        friend bool operator>=(const HybridFraction &lhs, const HybridFraction &rhs) { return compare(lhs, rhs) >= 0; }
+
+        /**
+         * @brief True if the value is stored inline rather than as a heap-allocated BigFraction.
+         */
+        bool is_inline() const noexcept { return denominator != 0; }
+
+        /**
+         * @brief Converts to a BigFraction.
+         */
+        BigFraction to_big() const;
+
+        /**
+         * @brief Converts to a Fraction.
+         *
+         * @throws std::overflow_error if a term does not fit in an int.
+         */
+        Fraction to_fraction() const;
+
+        /**
+         * @brief Converts to a double.
+         */
+        double to_double() const noexcept;
+
+        /**
+         * @brief Prints the fraction in the format "numerator/denominator".
+         */
+        friend std::ostream &operator<<(std::ostream &ostrm, const HybridFraction &fraction)
+        {
+            if (fraction.big)
+            {
+                return ostrm << *fraction.big;
+            }
+            ostrm << fraction.numerator << "/" << fraction.denominator;
+            return ostrm;
+        }
+    };
+}
+
+#endif